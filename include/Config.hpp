@@ -18,6 +18,10 @@ namespace glbl {
 
         // Частота кадров
         constexpr int frameRate = 60;
+        // Время перед сроком кадра, которое ограничитель ждёт в цикле, а не во сне (мс)
+        constexpr float limiterSpinMs = 2.f;
+        // Размер окна статистики времени кадров (в кадрах)
+        constexpr int frameStatsWindow = 600;
     }
 
     namespace render {
@@ -36,9 +40,76 @@ namespace glbl {
         constexpr bool faceVisible = true;
         // Отображение граней (только в упрощённом рендере)
         constexpr bool edgeVisible = false;
+        // Относительный запас теста глубины для рёбер: ребро лежит на своих гранях и не должно ими перекрываться
+        constexpr float edgeDepthBias = 0.01f;
+        // Тест глубины
+        constexpr bool depthTest = true;
+
+        // Режимы освещения (без освещения / плоское затенение по нормали треугольника)
+        enum class LightingMode { Unlit, Flat };
+        // Режим освещения
+        constexpr LightingMode lighting = LightingMode::Flat;
 
         // Упрощённый рендер
         constexpr bool liteRender = false;
+        // Буфер видимости (растеризация только глубины и идентификаторов, затем однократное затенение каждого пикселя)
+        constexpr bool visibilityBuffer = false;
+        // Отложенная очистка буфера глубины: очистка кадра только увеличивает номер кадра, а строка (или строка плиток)
+        // заполняется при первом обращении растеризатора (в своей полосе и пока она в кэше). Иначе весь буфер заполняется сразу
+        constexpr bool lazyDepthClear = true;
+        // Расположение буферов кадра плитками (пиксели плитки лежат в памяти подряд) вместо строк
+        constexpr bool tiledBuffers = false;
+        // Размер плитки в пикселях (степень двойки)
+        constexpr int tileSize = 8;
+
+        // Динамическое разрешение (внутренний буфер кадра подстраивается под целевое время растеризации)
+        constexpr bool dynamicResolution = true;
+        // Целевое время растеризации кадра (мс)
+        constexpr float frameTimeTarget = 16.6f;
+        // Минимальный масштаб разрешения
+        constexpr float minResolutionScale = 0.5f;
+    }
+
+    namespace simulation {
+        // Частота шагов симуляции (Гц), не зависит от частоты кадров рендера
+        constexpr int tickRate = 60;
+        // Наибольшее время кадра, которое симуляция догоняет (с), чтобы после долгой паузы не выполнять сотни шагов
+        constexpr float maxFrameTime = 0.25f;
+    }
+
+    namespace profiling {
+        // Профилирование стадий кадра (время и аппаратные счётчики, переключается клавишей F10)
+        constexpr bool stageProfiling = false;
+        // Число кадров между отчётами профилирования
+        constexpr int reportInterval = 120;
+
+        // Запись трассы кадров (выгружается клавишей F11 или после заданного числа кадров).
+        // По умолчанию выключена: её включает аргумент --trace-frames
+        constexpr bool tracing = false;
+        // Ёмкость кольца событий трассы одного потока (степень двойки)
+        constexpr unsigned int traceBufferEvents = 1 << 16;
+
+        // Число первых кадров, в которых выделения памяти допустимы (буферы растут до рабочего размера)
+        constexpr unsigned int allocationWarmupFrames = 3;
+    }
+
+    namespace jobs {
+        // Число рабочих потоков планировщика задач (0 — по числу ядер процессора)
+        constexpr unsigned int workerCount = 0;
+        // Число полос кадра на один поток при растеризации (больше полос — ровнее нагрузка)
+        constexpr int bandsPerThread = 4;
+    }
+
+    namespace mesh {
+        // Оптимизация моделей при загрузке: объединение одинаковых вершин и порядок треугольников для локальности вершин
+        constexpr bool optimizeOnLoad = true;
+        // Размер моделируемого кэша вершин при упорядочивании треугольников
+        constexpr int vertexCacheSize = 16;
+
+        // Упакованное хранение статических моделей: квантованные позиции и текстурные координаты, индексы вместо вершин
+        constexpr bool packedStatic = false;
+        // Число треугольников во фрагменте упакованной модели (позиции вершин хранятся относительно начала фрагмента)
+        constexpr int packedChunkTriangles = 1024;
     }
 
     // Функция для дебага
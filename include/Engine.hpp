@@ -2,23 +2,60 @@
 
 #include <SFML/Graphics.hpp>
 #include <vector>
+#include <thread>
+#include <chrono>
+#include <mutex>
+#include <sstream>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <atomic>
 
 #include "Config.hpp"
 #include "math/Vec3d.hpp"
 #include "components/geometry/Mesh.hpp"
+#include "components/geometry/MeshInstance.hpp"
 #include "components/lightning/Light.hpp"
+#include "components/CameraPath.hpp"
 #include "rendering/Render.hpp"
+#include "scene/Scene.hpp"
+#include "core/JobSystem.hpp"
+#include "core/SpscQueue.hpp"
+#include "core/FrameLimiter.hpp"
+#include "core/FrameStats.hpp"
+#include "core/Trace.hpp"
+#include "core/AllocationTracker.hpp"
+#include "rendering/FrameSnapshot.hpp"
+#include "rendering/RenderSettings.hpp"
+
+// Параметры запуска движка (задаются из командной строки)
+struct EngineOptions {
+    // Файл для записи пути камеры (пусто — путь не записывается)
+    std::string recordPath;
+    // Файл пути камеры для воспроизведения (пусто — камерой управляет пользователь)
+    std::string replayPath;
+    // Прогон без окна (только вместе с воспроизведением)
+    bool headless = false;
+    // Число кадров, после которого трасса кадров выгружается в файл (0 — только по клавише F11)
+    unsigned int traceFrames = 0;
+    // Проверка, что кадры после разогрева не выделяют динамическую память (прогон без окна, сборка с подсчётом выделений)
+    bool assertNoAllocations = false;
+};
 
 // Класс для управления основным циклом приложения (игровым движком)
 class Engine {
 public:
      // Конструктор (инициализация окна, камеры, света и модели)
-    Engine();
+    Engine(const EngineOptions& options = EngineOptions());
+    // Деструктор (остановка потока рендера до разрушения сцены и моделей)
+    ~Engine();
 
     // Основной цикл приложения
     void run();
 
 private:
+    // Параметры запуска
+    EngineOptions m_options;
     // Окно приложения
     sf::RenderWindow m_window;
     // Время, прошедшее с последнего кадра
@@ -31,23 +68,74 @@ private:
     // Флаг, указывающий, находится ли приложение в режиме паузы
     bool m_isPaused;
 
-    // Рендер (отвечает за отрисовку сцены)
+    // Планировщик задач (общий для всех параллельных частей движка)
+    JobSystem m_jobs;
+    // Граф сцены (объявлен раньше узлов, чтобы пережить их)
+    Scene m_scene;
+    // Рендер (отвечает за отрисовку сцены, работает в потоке рендера)
     Render m_render;
+    // Настройки рендера (переключаются в основном потоке, передаются рендеру в снимке кадра)
+    RenderSettings m_renderSettings;
+
+    // Очередь снимков кадров от основного потока к потоку рендера
+    SpscQueue<FrameSnapshot, 4> m_snapshots;
+    // Поток рендера
+    std::thread m_renderThread;
+    // Флаг работы потока рендера
+    std::atomic<bool> m_rendering;
+    // Число кадров, отрисованных потоком рендера
+    std::atomic<unsigned int> m_renderedFrames;
+    // Сводка времени кадров от потока рендера (для заголовка окна)
+    FrameStats::Summary m_frameStats;
+    // Выделения памяти за кадр рендера (в среднем за период публикации сводки)
+    AllocationTracker::Counts m_frameAllocations;
+    std::mutex m_frameStatsMutex;
     // Камера (управление видом сцены)
     Camera m_camera;
+    // Состояние камеры на предыдущем шаге симуляции (для интерполяции между шагами)
+    Camera m_previousCamera;
+    // Смещение мыши, накопленное с последнего шага симуляции
+    sf::Vector2i m_mouseDelta;
     // Источник света
     Light m_light;
 
-    // 3D-модель
+    // 3D-модель (геометрия)
     Mesh m_cube;
+    // Экземпляр модели в сцене
+    MeshInstance m_cubeInstance;
+
+    // Записываемый или воспроизводимый путь камеры
+    CameraPath m_cameraPath;
+    // Номер воспроизводимого шага пути
+    std::size_t m_replayTick;
+
+    // Число выгруженных трасс (номер следующего файла)
+    unsigned int m_traceDumps;
+    // Выгружена ли трасса после заданного числа кадров
+    bool m_traceFramesDumped;
 
     // Скорость перемещения и вращения камеры
     float m_cameraTranslateSpeed, m_cameraRotateSpeed;
 
     // Обработка событий (ввод пользователя)
     void handleEvents();
-    // Обновление состояния игры
-    void update();
-    // Отрисовка сцены
-    void draw();
+    // Шаг симуляции фиксированной длительности
+    void update(float dt);
+    // Управление камерой с клавиатуры и мыши
+    void moveCamera(float dt);
+    // Прогон без окна (воспроизведение пути камеры с выводом статистики кадров)
+    void runHeadless();
+    // Проверка, закончилось ли воспроизведение пути
+    bool isReplayFinished() const;
+    // Выгрузка трассы кадров в следующий файл trace_N.json
+    void dumpTrace();
+    // Передача снимка кадра потоку рендера (alpha — доля шага между предыдущим и текущим состоянием)
+    void submitFrame(float alpha);
+
+    // Запуск потока рендера
+    void startRenderThread();
+    // Остановка потока рендера
+    void stopRenderThread();
+    // Цикл потока рендера
+    void renderLoop();
 };
\ No newline at end of file
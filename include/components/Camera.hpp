@@ -14,7 +14,7 @@ public:
     Camera(Vec3d direction, Vec3d position);
 
     // Возвращает текущую позицию камеры
-    Vec3d getPos();
+    Vec3d getPos() const;
     // Возвращает текущее направление камеры
     Vec3d getDir();
 
@@ -50,6 +50,17 @@ public:
     // Вращение по вертикали (изменение угла fPitch)
     void rotateVertical(float offset);
 
+    // Угол поворота по горизонтали
+    float getYaw() const;
+    // Угол поворота по вертикали
+    float getPitch() const;
+
+    // Установка позиции и углов (при воспроизведении записанного пути)
+    void setState(const Vec3d& position, float yaw, float pitch);
+
+    // Камера между двумя состояниями (alpha = 0 — from, alpha = 1 — to)
+    static Camera interpolate(const Camera& from, const Camera& to, float alpha);
+
 private:
     // Позиция и направление камеры
     Vec3d pos = Vec3d(0), dir = Vec3d(0, 0, 1);
@@ -0,0 +1,47 @@
+#pragma once
+
+#include <vector>
+#include <string>
+#include <fstream>
+#include <stdexcept>
+#include <cstdint>
+#include <cstring>
+
+#include "Config.hpp"
+#include "math/Vec3d.hpp"
+#include "components/Camera.hpp"
+
+// Класс для записи и воспроизведения пути камеры (одно состояние на шаг симуляции)
+class CameraPath {
+public:
+    // Состояние камеры на одном шаге
+    struct Frame {
+        float x, y, z;
+        float yaw, pitch;
+    };
+
+    // Добавление текущего состояния камеры
+    void record(const Camera& camera);
+    // Установка камеры в состояние заданного шага
+    void apply(std::size_t index, Camera& camera) const;
+
+    // Число записанных шагов
+    std::size_t size() const;
+    // Частота шагов, с которой путь был записан
+    int getTickRate() const;
+
+    // Сохранение пути в файл
+    void save(const std::string& filename) const;
+    // Загрузка пути из файла
+    void load(const std::string& filename);
+
+private:
+    // Сигнатура и версия формата файла
+    static constexpr char magic[4] = {'C', 'P', 'T', 'H'};
+    static constexpr std::uint32_t version = 1;
+
+    // Частота шагов симуляции при записи
+    int m_tickRate = glbl::simulation::tickRate;
+    // Состояния камеры по шагам
+    std::vector<Frame> m_frames;
+};
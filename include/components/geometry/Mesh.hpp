@@ -8,37 +8,52 @@
 #include <algorithm>
 
 #include "Config.hpp"
+#include "core/Trace.hpp"
 #include "math/Mat4x4.hpp"
 #include "math/Vec3d.hpp"
 #include "math/Vec2d.hpp"
+#include "math/VertexTransform.hpp"
 #include "components/geometry/Triangle.hpp"
+#include "components/geometry/PackedMesh.hpp"
+#include "components/geometry/MeshOptimizer.hpp"
 #include "components/Camera.hpp"
 #include "components/props/Color.hpp"
 
-// Класс для работы с 3D-моделями
+// Класс для работы с 3D-моделями (общая геометрия, размещается в сцене через экземпляры MeshInstance)
 class Mesh {
 public:
+    // Способ хранения геометрии (целиком или в упакованном виде)
+    enum class Storage { Full, Packed };
+
     // Конструктор c загрузкой модели из файла
-    Mesh(const std::string& modelFilename);
+    Mesh(const std::string& modelFilename, Storage storage = glbl::mesh::packedStatic ? Storage::Packed : Storage::Full);
     // Конструктор c загрузкой модели и текстуры из файла
-    Mesh(const std::string& modelFilename, const std::string& textureFilename);
+    Mesh(const std::string& modelFilename, const std::string& textureFilename, Storage storage = glbl::mesh::packedStatic ? Storage::Packed : Storage::Full);
 
-    // Инициализация параметров модели (позиция, масштаб, угол)
-    void init();
     // Проверка, есть ли текстура у модели
     bool isTextured();
     // Получение текстуры модели
     sf::Image* getTexture();
 
-    // Перемещение модели
-    void translate(const Vec3d& offset);
-    // Масштабирование модели
-    void scale(const Vec3d& scale);
-    // Вращение модели
-    void rotate(const Vec3d& angle);
+    // Число треугольников модели
+    std::size_t getTriangleCount() const;
+    // Число вершин модели (после объединения одинаковых)
+    std::size_t getVertexCount() const;
+    // Треугольники модели в пространстве модели (пусто, если модель упакована)
+    const std::vector<Triangle>& getTriangles() const;
+    // Нормали треугольников в пространстве модели
+    const std::vector<Vec3d>& getNormals() const;
+    // Позиции вершин в пространстве модели (для пакетной трансформации; пусто, если модель упакована)
+    const PositionStreams& getPositions() const;
+    // Индексы вершин треугольников в потоках позиций (по три на треугольник; пусто, если модель упакована)
+    const std::vector<std::uint32_t>& getIndices() const;
+    // Упакованная модель (nullptr, если модель хранится целиком)
+    const PackedMesh* getPacked() const;
+    // Уникальные рёбра модели (вершины — в тех же потоках позиций, что и у треугольников)
+    const std::vector<MeshEdge>& getEdges() const;
 
-    // Получение трансформированных треугольников модели
-    std::vector<Triangle> getTransformedTriangles() const;
+    // Память, занимаемая геометрией модели (байт)
+    std::size_t getMemoryUsage() const;
 
 private:
     // Треугольники модели
@@ -47,9 +62,18 @@ private:
     std::vector<Vec3d> m_vertices;
     // Текстурные координаты
     std::vector<Vec2d> m_textureCoords;
-
-    // Позиция, масштаб и углы вращения модели
-    Vec3d m_position, m_scale, m_angle;
+    // Нормали треугольников в пространстве модели (вычисляются один раз при загрузке)
+    std::vector<Vec3d> m_normals;
+    // Позиции вершин в виде структуры массивов
+    PositionStreams m_positions;
+    // Индексы вершин треугольников
+    std::vector<std::uint32_t> m_indices;
+    // Уникальные рёбра (для каркасного режима)
+    std::vector<MeshEdge> m_edges;
+    // Упакованная модель (используется вместо треугольников и потоков позиций)
+    PackedMesh m_packed;
+    // Хранится ли модель в упакованном виде
+    bool m_isPacked;
 
     // Текстура модели
     sf::Image* m_texture = nullptr;
@@ -58,6 +82,14 @@ private:
     void loadModel(std::string filename);
     // Загрузка текстуры
     void loadTexture(std::string filename);
+    // Вычисление нормалей треугольников в пространстве модели
+    void computeNormals();
+    // Заполнение потоков позиций вершин
+    void buildPositionStreams();
+    // Объединение вершин и оптимизация порядка треугольников и вершин
+    void optimize();
+    // Подготовка геометрии после загрузки (нормали и потоки позиций или упаковка)
+    void finalizeGeometry();
 
     // Обработка строки файла .obj
     void parseLine(std::string& line);
@@ -0,0 +1,42 @@
+#pragma once
+
+#include <SFML/Graphics.hpp>
+
+#include "math/Mat4x4.hpp"
+#include "math/Vec3d.hpp"
+#include "scene/SceneNode.hpp"
+#include "components/geometry/Mesh.hpp"
+#include "components/props/Color.hpp"
+
+// Класс для экземпляра модели: узел сцены с оформлением поверх общей геометрии Mesh
+class MeshInstance : public SceneNode {
+public:
+    // Конструктор (экземпляр ссылается на геометрию, но не копирует её)
+    MeshInstance(Mesh& mesh);
+
+    // Получение общей геометрии
+    Mesh& getMesh() const;
+
+    // Установка оттенка (цвет текстуры или треугольников умножается на него)
+    void setTint(const Color& tint);
+    // Получение оттенка (белый, если оттенок не задан)
+    const Color& getTint() const;
+    // Проверка, задан ли оттенок
+    bool isTinted() const;
+
+    // Замена текстуры модели для этого экземпляра (nullptr — использовать текстуру модели)
+    void setTexture(sf::Image* texture);
+    // Получение текстуры экземпляра
+    sf::Image* getTexture() const;
+
+private:
+    // Общая геометрия
+    Mesh* m_mesh;
+
+    // Оттенок экземпляра
+    Color m_tint;
+    // Флаг наличия оттенка
+    bool m_tinted = false;
+    // Текстура экземпляра (nullptr — текстура модели)
+    sf::Image* m_texture = nullptr;
+};
@@ -0,0 +1,41 @@
+#pragma once
+
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+#include "math/VertexTransform.hpp"
+#include "components/geometry/Triangle.hpp"
+
+// Ребро модели: две вершины и соседние треугольники (ребро, общее для нескольких треугольников, хранится один раз)
+struct MeshEdge {
+    // Нет второго соседнего треугольника (граничное ребро)
+    static constexpr std::uint32_t noTriangle = UINT32_MAX;
+
+    // Вершины ребра в потоках позиций
+    std::uint32_t vertices[2];
+    // Соседние треугольники
+    std::uint32_t triangles[2];
+};
+
+// Класс для оптимизации геометрии модели при загрузке: объединение одинаковых вершин,
+// порядок треугольников для локальности вершин (Tipsify) и порядок вершин по первому использованию
+class MeshOptimizer {
+public:
+    // Объединение вершин с одинаковыми позицией и текстурными координатами.
+    // indices получает по три индекса вершины на треугольник, результат — угол (треугольник * 3 + вершина), задающий каждую вершину
+    static std::vector<std::uint32_t> weld(const std::vector<Triangle>& triangles, std::vector<std::uint32_t>& indices);
+
+    // Порядок треугольников, при котором недавно использованные вершины используются снова (алгоритм Tipsify,
+    // Sander, Nehab, Barczak, 2007). Результат — старый номер треугольника для каждой новой позиции
+    static std::vector<std::uint32_t> orderTriangles(const std::vector<std::uint32_t>& indices, std::size_t vertexCount, int cacheSize);
+
+    // Нумерация вершин в порядке первого использования (индексы переписываются на месте).
+    // Результат — старый номер вершины для каждого нового
+    static std::vector<std::uint32_t> orderVertices(std::vector<std::uint32_t>& indices, std::size_t vertexCount);
+
+    // Уникальные рёбра по индексам треугольников и позициям их вершин. Вершины с одинаковой позицией считаются одной
+    // (вершины ребра — первые из них в потоках позиций), поэтому ребро на шве текстуры хранится один раз.
+    // Ребро, общее для больше чем двух треугольников, повторяется для каждой следующей пары соседей
+    static std::vector<MeshEdge> uniqueEdges(const std::vector<std::uint32_t>& indices, const PositionStreams& positions);
+};
@@ -0,0 +1,73 @@
+#pragma once
+
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+#include "Config.hpp"
+#include "math/Vec2d.hpp"
+#include "math/Vec3d.hpp"
+#include "math/VertexTransform.hpp"
+#include "components/geometry/Triangle.hpp"
+
+// Класс для упакованного хранения статической модели: треугольники хранят индексы вершин, вершины — 16-битные
+// позиции относительно начала своего фрагмента и 16-битные текстурные координаты. Распаковка выполняется на стадии трансформации
+class PackedMesh {
+public:
+    // Фрагмент модели: подряд идущие треугольники со своими вершинами
+    struct Chunk {
+        // Начало фрагмента на общей сетке квантования модели (в шагах сетки)
+        std::uint32_t origin[3];
+        // Первая вершина фрагмента и число его вершин
+        std::uint32_t firstVertex, vertexCount;
+    };
+
+    // Упаковка треугольников (одинаковые вершины внутри фрагмента объединяются)
+    void build(const std::vector<Triangle>& triangles);
+
+    // Число треугольников
+    std::size_t getTriangleCount() const { return m_indices.size() / 3; }
+    // Число вершин
+    std::size_t getVertexCount() const { return m_x.size(); }
+
+    // Распаковка позиций всех вершин в пространство модели
+    void decodePositions(PositionStreams& out) const;
+    // Трансформация позиций всех вершин матрицей mat (распаковка выполняется внутри трансформации, по фрагментам)
+    void transformPositions(const Mat4x4& mat, PositionStreams& out) const;
+    // Распаковка позиции вершины треугольника (та же, что у decodePositions)
+    Vec3d getPosition(std::size_t triangle, std::uint32_t vertex) const {
+        const Chunk& chunk = m_chunks[triangle / glbl::mesh::packedChunkTriangles];
+        return Vec3d(m_posMin.x + static_cast<float>(chunk.origin[0] + m_x[vertex]) * m_posStep.x,
+                     m_posMin.y + static_cast<float>(chunk.origin[1] + m_y[vertex]) * m_posStep.y,
+                     m_posMin.z + static_cast<float>(chunk.origin[2] + m_z[vertex]) * m_posStep.z);
+    }
+    // Индексы вершин треугольника в потоках распакованных позиций
+    void getCorners(std::size_t triangle, std::uint32_t corners[3]) const {
+        const Chunk& chunk = m_chunks[triangle / glbl::mesh::packedChunkTriangles];
+        for (int j = 0; j < 3; j++) { corners[j] = chunk.firstVertex + m_indices[triangle * 3 + j]; }
+    }
+    // Распаковка текстурных координат вершины
+    Vec2d getTextureCoords(std::uint32_t vertex) const {
+        return Vec2d(m_uvMin.u + m_u[vertex] * m_uvStep.u, m_uvMin.v + m_v[vertex] * m_uvStep.v);
+    }
+    // Распаковка треугольника целиком (для однократных вычислений при загрузке)
+    Triangle decodeTriangle(std::size_t triangle) const;
+
+    // Занимаемая память (байт)
+    std::size_t getMemoryUsage() const;
+
+private:
+    // Начало и шаг общей сетки квантования позиций
+    Vec3d m_posMin, m_posStep;
+    // Начало и шаг квантования текстурных координат
+    Vec2d m_uvMin, m_uvStep;
+
+    // Фрагменты модели (по glbl::mesh::packedChunkTriangles треугольников)
+    std::vector<Chunk> m_chunks;
+    // Квантованные позиции вершин относительно начала фрагмента
+    std::vector<std::uint16_t> m_x, m_y, m_z;
+    // Квантованные текстурные координаты вершин
+    std::vector<std::uint16_t> m_u, m_v;
+    // Индексы вершин треугольников внутри фрагмента (по три на треугольник)
+    std::vector<std::uint16_t> m_indices;
+};
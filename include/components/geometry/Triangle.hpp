@@ -34,8 +34,8 @@ public:
     // Установка текстурных координат
     void setTextureCoords(Vec2d t1, Vec2d t2, Vec2d t3);
 
-    // Масштабирование треугольника для отображения на экране
-    void scalingToDisplay();
+    // Масштабирование треугольника для отображения на экране (размеры буфера кадра)
+    void scalingToDisplay(float width, float height);
 
     // Получение нормали треугольника
     Vec3d getNormal() const;
@@ -44,13 +44,10 @@ public:
     void projectionDiv();
 
     // Умножение треугольника на матрицу трансформации
-    Triangle operator*(const Mat4x4& mat);
+    Triangle operator*(const Mat4x4& mat) const;
     // Умножение треугольника на матрицу с присваиванием
     Triangle& operator*=(const Mat4x4& mat);
 
-    // Отрисовка текстурированного треугольника
-    sf::VertexArray texturedTriangle(DepthBuffer& depthBuffer, sf::Image* texture);
-
     // Отсечение треугольника относительно плоскости
     static int clipAgainsPlane(const Vec3d& planePoint, const Vec3d& planeNormal, const Triangle& inTri, Triangle& outTri1, Triangle& outTri2);
 
@@ -15,4 +15,6 @@ public:
 
     // Перегрузка оператора для умножения на яркость
     Color operator*(float brightness);
+    // Покомпонентное умножение на другой цвет (оттенок)
+    Color modulate(const Color& other) const;
 };
\ No newline at end of file
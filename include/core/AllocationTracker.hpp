@@ -0,0 +1,44 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+// Класс для подсчёта выделений динамической памяти. Подсчёт включается опцией сборки ENGINE_TRACK_ALLOCATIONS
+// (заменяет глобальные operator new/delete); без неё все значения нулевые и подсчёт ничего не стоит.
+// Учитываются только потоки, отмеченные для подсчёта (поток рендера и рабочие потоки планировщика)
+class AllocationTracker {
+public:
+    // Число выделений и их суммарный размер
+    struct Counts {
+        std::uint64_t allocations = 0;
+        std::uint64_t bytes = 0;
+
+        Counts operator-(const Counts& other) const { return {allocations - other.allocations, bytes - other.bytes}; }
+        Counts& operator+=(const Counts& other) {
+            allocations += other.allocations;
+            bytes += other.bytes;
+            return *this;
+        }
+    };
+
+#ifdef ENGINE_TRACK_ALLOCATIONS
+    // Собран ли подсчёт
+    static constexpr bool enabled = true;
+#else
+    static constexpr bool enabled = false;
+#endif
+
+    // Включение подсчёта выделений текущего потока
+    static void trackCurrentThread(bool tracked = true);
+    // Выделения отмеченных потоков с начала работы (разность двух значений — выделения за отрезок)
+    static Counts get();
+
+    // Учёт выделения (вызывается из operator new)
+    static void record(std::size_t bytes);
+
+private:
+    // Счётчики всех отмеченных потоков
+    static std::atomic<std::uint64_t> s_allocations;
+    static std::atomic<std::uint64_t> s_bytes;
+};
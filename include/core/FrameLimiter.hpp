@@ -0,0 +1,27 @@
+#pragma once
+
+#include <chrono>
+#include <thread>
+
+#include "Config.hpp"
+
+// Класс для ограничения частоты кадров: сон до момента незадолго до срока, затем точное ожидание в цикле.
+// Сроки отсчитываются от монотонных часов и не накапливают погрешность сна
+class FrameLimiter {
+public:
+    // Конструктор (частота кадров и время ожидания в цикле перед сроком, мс)
+    explicit FrameLimiter(float frameRate, float spinMs = glbl::window::limiterSpinMs);
+
+    // Ожидание срока следующего кадра
+    void wait();
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    // Длительность кадра
+    Clock::duration m_period;
+    // Часть ожидания, выполняемая в цикле (сон системы слишком груб для неё)
+    Clock::duration m_spin;
+    // Срок текущего кадра
+    Clock::time_point m_deadline;
+};
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <array>
+#include <vector>
+#include <algorithm>
+#include <cmath>
+
+#include "Config.hpp"
+
+// Класс для статистики времени кадров за скользящее окно: гистограмма для процентилей и число пропущенных кадров
+class FrameStats {
+public:
+    // Сводка по окну (время в миллисекундах)
+    struct Summary {
+        float p50 = 0, p95 = 0, p99 = 0, max = 0;
+        // Пропущенные кадры в окне и за всё время
+        unsigned int dropped = 0, droppedTotal = 0;
+    };
+
+    // Конструктор (бюджет кадра в мс и размер окна в кадрах)
+    FrameStats(float budgetMs, int window = glbl::window::frameStatsWindow);
+
+    // Добавление времени кадра
+    void add(float frameMs);
+    // Сводка по текущему окну
+    Summary getSummary() const;
+
+private:
+    // Ширина корзины гистограммы (мс) и число корзин (последняя собирает всё, что дольше)
+    static constexpr float bucketMs = 0.1f;
+    static constexpr int bucketCount = 1000;
+
+    // Гистограмма времён кадров в окне
+    std::array<unsigned int, bucketCount> m_histogram{};
+    // Времена кадров окна (кольцо, самый старый кадр уходит из гистограммы при добавлении нового)
+    std::vector<float> m_samples;
+    int m_next = 0, m_count = 0;
+
+    // Порог пропущенного кадра (больше полутора бюджетов — кадр не успел к своему сроку)
+    float m_dropThreshold;
+    // Пропущенные кадры в окне и за всё время
+    unsigned int m_dropped = 0, m_droppedTotal = 0;
+
+    // Корзина гистограммы для времени кадра
+    static int bucket(float frameMs);
+    // Время кадра для заданной доли окна (верхняя граница корзины)
+    float percentile(float fraction) const;
+};
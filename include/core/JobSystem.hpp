@@ -0,0 +1,166 @@
+#pragma once
+
+#include <thread>
+#include <vector>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <memory>
+#include <new>
+#include <cstddef>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <algorithm>
+
+#include "Config.hpp"
+#include "core/Trace.hpp"
+#include "core/AllocationTracker.hpp"
+
+// Класс для планировщика задач движка: фиксированные рабочие потоки, у каждого своя очередь,
+// свободные потоки забирают задачи из чужих очередей. Один планировщик на весь движок, чтобы
+// параллельные части (рендер, отсечение, загрузка ресурсов) не создавали лишних потоков
+class JobSystem {
+public:
+    // Задача: функция с данными во встроенном буфере и счётчик незавершённых подзадач
+    struct Job {
+        // Функция, выполняющая задачу (вызывает сохранённый объект и разрушает его)
+        void (*function)(Job& job);
+        // Родительская задача (завершается после всех дочерних)
+        Job* parent;
+        // Число незавершённых задач: сама задача и её дочерние
+        std::atomic<int> unfinished;
+        // Место под вызываемый объект (без выделения памяти на каждую задачу)
+        alignas(std::max_align_t) unsigned char data[64];
+    };
+
+    // Конструктор (0 рабочих потоков — по числу ядер процессора минус вызывающий поток)
+    explicit JobSystem(unsigned int workerCount = glbl::jobs::workerCount);
+    // Деструктор (остановка рабочих потоков)
+    ~JobSystem();
+
+    // Запрет копирования
+    JobSystem(const JobSystem&) = delete;
+    JobSystem& operator=(const JobSystem&) = delete;
+
+    // Число потоков, выполняющих задачи (рабочие и поток, создавший планировщик)
+    unsigned int getThreadCount() const;
+    // Идентификаторы рабочих потоков в системе (для профилировщиков; пусто, если система их не даёт)
+    std::vector<int> getWorkerThreadIds() const;
+
+    // Создание задачи (дочерняя задача задерживает завершение родителя)
+    template<typename F>
+    Job* create(F&& function, Job* parent = nullptr);
+    // Постановка задачи в очередь текущего потока
+    void run(Job* job);
+    // Ожидание завершения задачи (ожидающий поток тем временем выполняет другие задачи)
+    void wait(const Job* job);
+
+    // Параллельный цикл: function(begin, end) вызывается для отрезков [0, count) длиной не больше grain
+    template<typename F>
+    void parallelFor(int count, int grain, F&& function);
+
+private:
+    // Ёмкость очереди и пула задач одного потока (степень двойки)
+    static constexpr unsigned int capacity = 4096;
+    // Наибольшее число отрезков одного параллельного цикла (остальная часть пула остаётся для вложенных задач)
+    static constexpr int maxChunks = capacity / 4;
+    // Число мест для потоков, не принадлежащих планировщику (например, поток рендера)
+    static constexpr unsigned int externalThreads = 4;
+
+    // Очередь задач потока: владелец берёт с конца, остальные потоки забирают с начала
+    struct Queue {
+        std::mutex mutex;
+        Job* jobs[capacity];
+        unsigned int head = 0, tail = 0;
+    };
+    // Пул задач потока (кольцо, задачи переиспользуются по кругу)
+    struct Pool {
+        std::unique_ptr<Job[]> jobs;
+        unsigned int next = 0;
+    };
+
+    // Рабочие потоки
+    std::vector<std::thread> m_workers;
+    // Идентификаторы рабочих потоков в системе (заполняются самими потоками при запуске)
+    std::unique_ptr<std::atomic<int>[]> m_workerThreadIds;
+    // Очереди и пулы задач (по одному на каждый поток)
+    std::unique_ptr<Queue[]> m_queues;
+    std::unique_ptr<Pool[]> m_pools;
+    // Число мест для потоков
+    unsigned int m_slotCount;
+    // Следующее свободное место для внешнего потока
+    std::atomic<unsigned int> m_nextExternalSlot;
+
+    // Флаг работы планировщика
+    std::atomic<bool> m_running;
+    // Число задач в очередях
+    std::atomic<int> m_pending;
+    // Ожидание новых задач простаивающими рабочими потоками
+    std::mutex m_sleepMutex;
+    std::condition_variable m_wake;
+
+    // Место текущего потока
+    unsigned int slot();
+    // Выделение задачи из пула текущего потока
+    Job* allocate(Job* parent);
+
+    // Добавление задачи в конец очереди
+    bool push(unsigned int slot, Job* job);
+    // Извлечение задачи с конца своей очереди
+    Job* pop(unsigned int slot);
+    // Извлечение задачи с начала чужой очереди
+    Job* steal(unsigned int slot);
+    // Поиск задачи для текущего потока
+    Job* getJob();
+
+    // Выполнение задачи
+    void execute(Job* job);
+    // Завершение задачи (и родителя, если это была последняя дочерняя)
+    void finish(Job* job);
+
+    // Цикл рабочего потока
+    void workerLoop(unsigned int slot);
+};
+
+// Создание задачи
+template<typename F>
+JobSystem::Job* JobSystem::create(F&& function, Job* parent) {
+    using Func = std::decay_t<F>;
+    static_assert(sizeof(Func) <= sizeof(Job::data), "Job function does not fit into the job storage");
+    static_assert(alignof(Func) <= alignof(std::max_align_t), "Job function is over-aligned");
+
+    Job* job = allocate(parent);
+    new (job->data) Func(std::forward<F>(function));
+    job->function = [](Job& job) {
+        Func& func = *std::launder(reinterpret_cast<Func*>(job.data));
+        func();
+        func.~Func();
+    };
+    return job;
+}
+
+// Параллельный цикл
+template<typename F>
+void JobSystem::parallelFor(int count, int grain, F&& function) {
+    if (count <= 0) return;
+    // Число отрезков ограничено, чтобы цикл не занимал весь пул задач потока (например, по отрезку на каждый
+    // из тысяч экземпляров сцены)
+    grain = std::max({grain, 1, (count + maxChunks - 1) / maxChunks});
+
+    // Единственный отрезок выполняется сразу, без постановки в очередь
+    if (count <= grain) {
+        function(0, count);
+        return;
+    }
+
+    // Пустая корневая задача ждёт все отрезки
+    Job* root = create([] {});
+    for (int begin = 0; begin < count; begin += grain) {
+        int end = std::min(begin + grain, count);
+        run(create([&function, begin, end] { function(begin, end); }, root));
+    }
+
+    execute(root);
+    wait(root);
+}
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <array>
+#include <vector>
+#include <string>
+#include <cstdint>
+
+// Класс для аппаратных счётчиков процессора (Linux perf_event_open): такты, инструкции, промахи кэшей и
+// предсказателя переходов. Счётчики открываются для набора потоков и читаются как сумма по ним.
+// Если счётчики недоступны (другая система, контейнер, запрет ядра), набор просто остаётся пустым
+class PerfCounters {
+public:
+    // Отслеживаемые события
+    enum Event { Cycles, Instructions, L1Misses, LlcMisses, BranchMisses, EventCount };
+    // Значения всех событий
+    using Values = std::array<std::uint64_t, EventCount>;
+
+    // Конструктор и деструктор (закрытие счётчиков)
+    PerfCounters() = default;
+    ~PerfCounters();
+
+    // Запрет копирования (счётчики владеют дескрипторами)
+    PerfCounters(const PerfCounters&) = delete;
+    PerfCounters& operator=(const PerfCounters&) = delete;
+
+    // Открытие счётчиков для потоков (идентификаторы потоков системы, 0 — вызывающий поток).
+    // Возвращает false, если не открылось ни одно событие; причина доступна через getError
+    bool open(const std::vector<int>& threadIds);
+    // Закрытие счётчиков
+    void close();
+
+    // Открыт ли хотя бы один счётчик
+    bool isOpen() const;
+    // Доступно ли событие
+    bool isAvailable(Event event) const;
+    // Причина недоступности счётчиков
+    const std::string& getError() const;
+
+    // Текущие значения событий (сумма по потокам, с поправкой на разделение счётчиков между событиями)
+    Values read() const;
+
+    // Короткое имя события для отчёта
+    static const char* getName(Event event);
+
+private:
+    // Открытый счётчик одного события одного потока
+    struct Counter {
+        int fd;
+        Event event;
+    };
+
+    // Открытые счётчики
+    std::vector<Counter> m_counters;
+    // Доступность событий
+    std::array<bool, EventCount> m_available{};
+    // Причина недоступности счётчиков
+    std::string m_error;
+};
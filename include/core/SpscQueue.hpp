@@ -0,0 +1,48 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+
+// Класс для кольцевой очереди без блокировок с одним производителем и одним потребителем.
+// Элементы заранее созданы и переиспользуются: производитель заполняет свободный элемент на месте,
+// поэтому передача через очередь не копирует данные и не выделяет память
+template<typename T, std::size_t Capacity>
+class SpscQueue {
+    static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0, "Queue capacity must be a power of two");
+
+public:
+    // Свободный элемент для заполнения производителем (nullptr, если очередь заполнена)
+    T* beginPush() {
+        std::size_t tail = m_tail.load(std::memory_order_relaxed);
+        if (tail - m_head.load(std::memory_order_acquire) == Capacity) return nullptr;
+        return &m_items[tail & (Capacity - 1)];
+    }
+    // Публикация заполненного элемента
+    void endPush() {
+        m_tail.store(m_tail.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+    }
+
+    // Самый старый опубликованный элемент (nullptr, если очередь пуста)
+    T* front() {
+        std::size_t head = m_head.load(std::memory_order_relaxed);
+        if (head == m_tail.load(std::memory_order_acquire)) return nullptr;
+        return &m_items[head & (Capacity - 1)];
+    }
+    // Освобождение элемента потребителем
+    void pop() {
+        m_head.store(m_head.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+    }
+
+    // Число опубликованных элементов (точное только для потребителя)
+    std::size_t size() const {
+        return m_tail.load(std::memory_order_acquire) - m_head.load(std::memory_order_relaxed);
+    }
+
+private:
+    // Элементы очереди
+    std::array<T, Capacity> m_items;
+    // Индексы потребителя и производителя (в разных строках кэша, чтобы потоки не мешали друг другу)
+    alignas(64) std::atomic<std::size_t> m_head{0};
+    alignas(64) std::atomic<std::size_t> m_tail{0};
+};
@@ -0,0 +1,66 @@
+#pragma once
+
+#include <chrono>
+#include <vector>
+#include <iostream>
+#include <iomanip>
+#include <sstream>
+#include <algorithm>
+
+#include "Config.hpp"
+#include "core/PerfCounters.hpp"
+#include "core/Trace.hpp"
+#include "core/AllocationTracker.hpp"
+
+// Класс для профилирования стадий кадра: время каждой стадии, аппаратные счётчики и выделения памяти за неё.
+// Средние значения за несколько кадров выводятся в консоль; без счётчиков выводится только время.
+// Границы стадий также записываются в трассу кадров, если она включена
+class StageProfiler {
+public:
+    // Конструктор (число кадров между отчётами)
+    explicit StageProfiler(int reportInterval = glbl::profiling::reportInterval);
+
+    // Включение и выключение (счётчики открываются для переданных потоков, 0 — вызывающий поток)
+    void setEnabled(bool enabled, const std::vector<int>& threadIds);
+    // Включено ли профилирование
+    bool isEnabled() const;
+
+    // Начало кадра
+    void beginFrame();
+    // Завершение стадии, начавшейся в конце предыдущей (или в начале кадра)
+    void endStage(const char* name);
+    // Завершение кадра (раз в несколько кадров выводится отчёт)
+    void endFrame();
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    // Накопленные за отчётный период значения стадии
+    struct Stage {
+        const char* name;
+        double ms;
+        PerfCounters::Values counters;
+        AllocationTracker::Counts allocations;
+    };
+
+    // Включено ли профилирование
+    bool m_enabled = false;
+    // Аппаратные счётчики
+    PerfCounters m_counters;
+    // Число потоков, для которых открыты счётчики
+    std::size_t m_threadCount = 0;
+
+    // Число кадров между отчётами и число кадров в текущем периоде
+    int m_reportInterval;
+    int m_frames = 0;
+    // Стадии в порядке первого появления
+    std::vector<Stage> m_stages;
+
+    // Начало текущей стадии
+    Clock::time_point m_stageStart;
+    PerfCounters::Values m_stageValues{};
+    AllocationTracker::Counts m_stageAllocations;
+
+    // Вывод отчёта и сброс накопленных значений
+    void report();
+};
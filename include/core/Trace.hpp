@@ -0,0 +1,88 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include <string>
+#include <fstream>
+#include <cstdint>
+#include <algorithm>
+
+#include "Config.hpp"
+
+// Запись отрезка текущей области видимости в трассу (имя — строковый литерал)
+#define TRACE_CONCAT_IMPL(a, b) a##b
+#define TRACE_CONCAT(a, b) TRACE_CONCAT_IMPL(a, b)
+#define TRACE_SCOPE(name) Trace::Scope TRACE_CONCAT(traceScope, __LINE__)(name)
+
+// Класс для трассировки временной шкалы кадров: каждый поток пишет отрезки (начало и конец) в своё кольцо
+// без блокировок, трасса выгружается в формате Chrome Trace Event (открывается в chrome://tracing и Perfetto).
+// В кольце хранятся последние события каждого потока, поэтому выгрузка показывает последние кадры
+class Trace {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    // Отрезок области видимости (запись в трассу при выходе из области)
+    class Scope {
+    public:
+        explicit Scope(const char* name) : m_name(name), m_start(Trace::isEnabled() ? Clock::now() : Clock::time_point()) {}
+        ~Scope() { if (m_start != Clock::time_point()) { Trace::record(m_name, m_start, Clock::now()); } }
+
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+
+    private:
+        const char* m_name;
+        Clock::time_point m_start;
+    };
+
+    // Включение и выключение записи
+    static void setEnabled(bool enabled);
+    // Включена ли запись
+    static bool isEnabled() { return s_enabled.load(std::memory_order_relaxed); }
+
+    // Имя текущего потока в трассе
+    static void setThreadName(const std::string& name);
+    // Запись отрезка (имя — строковый литерал или строка, живущая до выгрузки)
+    static void record(const char* name, Clock::time_point start, Clock::time_point end);
+
+    // Выгрузка трассы всех потоков в файл JSON (false, если файл не удалось записать)
+    static bool dump(const std::string& filename);
+
+private:
+    // Событие трассы
+    struct Event {
+        const char* name;
+        // Начало и длительность (нс от начала трассы)
+        std::int64_t start;
+        std::int64_t duration;
+    };
+
+    // Кольцо событий одного потока: пишет только сам поток, читает выгрузка
+    struct ThreadBuffer {
+        // События (выделяются при первой записи под блокировкой s_buffersMutex)
+        std::unique_ptr<Event[]> events;
+        // Число записанных событий за всё время (позиция записи в кольце)
+        std::atomic<std::uint64_t> head{0};
+        // Номер потока в трассе и его имя
+        int id = 0;
+        std::string name;
+    };
+
+    // Ёмкость кольца (степень двойки)
+    static constexpr std::uint64_t capacity = glbl::profiling::traceBufferEvents;
+    static_assert((capacity & (capacity - 1)) == 0, "Trace buffer capacity must be a power of two");
+
+    // Включена ли запись
+    static std::atomic<bool> s_enabled;
+    // Начало трассы
+    static const Clock::time_point s_epoch;
+    // Кольца всех потоков (живут до конца программы, чтобы выгрузка видела и завершившиеся потоки)
+    static std::mutex s_buffersMutex;
+    static std::vector<std::unique_ptr<ThreadBuffer>> s_buffers;
+
+    // Кольцо текущего потока (создаётся при первой записи)
+    static ThreadBuffer& threadBuffer();
+};
@@ -0,0 +1,74 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+// Варианты ядер под наборы инструкций x86-64 собираются только для этих процессоров.
+// Заголовок намеренно не подключает стандартных контейнеров: он входит в единицы трансляции, собранные
+// с флагами AVX2/AVX-512, и встраиваемые функции из них не должны попасть в общий код программы
+#if defined(__x86_64__) || defined(_M_X64)
+#define ENGINE_KERNELS_X86 1
+#else
+#define ENGINE_KERNELS_X86 0
+#endif
+
+// Набор горячих ядер, собранных под один уровень набора инструкций.
+// Все варианты вычисляют одно и то же в одном порядке операций: результат не зависит от выбранного уровня
+struct KernelTable {
+    // Трансформация точек (w = 1) матрицей 4x4 (m — 16 чисел по строкам), выходные массивы могут совпадать с входными
+    void (*transformPoints)(const float* m, const float* x, const float* y, const float* z, std::size_t count,
+                            float* outX, float* outY, float* outZ, float* outW);
+    // Классификация точек относительно плоскости (plane — нормаль и её скалярное произведение с точкой плоскости):
+    // inside[i] = 1, если точка лежит с той стороны, куда смотрит нормаль (как в Triangle::clipAgainsPlane)
+    void (*classifyPlane)(const float* plane, const float* x, const float* y, const float* z, std::size_t count, std::uint8_t* inside);
+    // Заполнение массива 32-битным значением (очистка буферов глубины и видимости)
+    void (*fill32)(void* dst, std::uint32_t value, std::size_t count);
+    // Заполнение массива 32-битным значением потоковой записью в обход кэша (dst выровнен хотя бы на 4 байта).
+    // Для больших буферов, которые не читаются сразу после заполнения: запись не вытесняет кэш и не читает строки памяти перед записью
+    void (*streamFill32)(void* dst, std::uint32_t value, std::size_t count);
+    // Отрезок строки буфера видимости: W интерполируется от startW до endW, параметр начинается с t и растёт на tStep за пиксель,
+    // ближние пиксели (W больше записанного) получают новую глубину и идентификатор треугольника.
+    // Возвращает параметр после отрезка: строка, разбитая на участки, продолжается со следующего участка
+    float (*visibilitySpan)(float* depth, std::uint32_t* ids, int count, float startW, float endW, float t, float tStep, std::uint32_t id);
+    // Выборка текстуры без фильтрации (texels — пиксели RGBA, u и v — координаты в [0, 1]) в упакованные цвета RGBA
+    void (*sampleNearest)(const void* texels, unsigned int width, unsigned int height, const float* u, const float* v, std::size_t count, std::uint32_t* out);
+};
+
+// Класс для выбора варианта ядер: уровень набора инструкций определяется по CPUID один раз при запуске.
+// Один исполняемый файл работает на процессорах с SSE4.2 и использует AVX2/AVX-512 там, где они есть
+class Kernels {
+public:
+    // Уровни набора инструкций (по возрастанию)
+    enum Level { Scalar, Sse42, Avx2, Avx512, LevelCount };
+
+    // Ядра выбранного уровня (до выбора — скалярные)
+    static const KernelTable& get() { return *s_table; }
+    // Выбранный уровень
+    static Level getLevel() { return s_level; }
+
+    // Наибольший уровень, который поддерживают процессор и операционная система
+    static Level detect();
+    // Выбор уровня (false, если процессор его не поддерживает или вариант не собран для этой платформы).
+    // Вызывается до запуска потоков движка
+    static bool select(Level level);
+
+    // Имя уровня (как в аргументе --isa и переменной окружения ENGINE_ISA)
+    static const char* getName(Level level);
+    // Уровень по имени (false, если имя неизвестно)
+    static bool parseLevel(const char* name, Level& level);
+
+private:
+    // Таблица и уровень выбранного варианта
+    static const KernelTable* s_table;
+    static Level s_level;
+};
+
+// Таблицы вариантов (определены в отдельных единицах трансляции со своими флагами компилятора)
+namespace kernels {
+    extern const KernelTable scalar;
+#if ENGINE_KERNELS_X86
+    extern const KernelTable sse42;
+    extern const KernelTable avx2;
+    extern const KernelTable avx512;
+#endif
+}
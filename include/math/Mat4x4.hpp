@@ -5,38 +5,101 @@
 #include <cmath>
 
 #include "Config.hpp"
+#include "math/Simd.hpp"
 
 // Даём знать программе, что существует класс Vec3d (для использования в методах)
 class Vec3d;
 
-// Класс для работы с матрицей 4x4 (используется для трансформаций и проекций)
-class Mat4x4 {
+// Класс для работы с матрицей 4x4 (используется для трансформаций и проекций).
+// Строки выровнены по 16 байт и загружаются в регистры SSE; постоянные матрицы вычисляются при компиляции
+class alignas(16) Mat4x4 {
 public:
     // Матрица 4x4 (двумерный массив)
-    std::array<std::array<float, 4>, 4> m;
+    std::array<std::array<float, 4>, 4> m{};
 
     // Конструктор по умолчанию
-    Mat4x4() = default;
+    constexpr Mat4x4() = default;
     // Инициализация списком значений
-    Mat4x4(std::initializer_list<std::initializer_list<float>> values);
+    constexpr Mat4x4(std::initializer_list<std::initializer_list<float>> values) {
+        int i = 0;
+        for (const auto& row : values) {
+            int j = 0;
+            for (const auto& val : row) { m[i][j++] = val; }
+            i++;
+        }
+    }
 
     // Перегрузка оператора умножения матриц
     Mat4x4 operator*(const Mat4x4& other) const;
 
+#if ENGINE_SSE
+    // Строка матрицы в регистре
+    __m128 row(int i) const { return _mm_load_ps(m[i].data()); }
+#endif
+
     // Матрица перемещения
-    static Mat4x4 translation(float x, float y, float z);
+    static constexpr Mat4x4 translation(float x, float y, float z) {
+        return Mat4x4{
+            { 1,  0,  0,  0 },
+            { 0,  1,  0,  0 },
+            { 0,  0,  1,  0 },
+            { x,  y,  z,  1 }
+        };
+    }
     // Матрица масштабирования
-    static Mat4x4 scale(float scaleX, float scaleY, float scaleZ);
+    static constexpr Mat4x4 scale(float scaleX, float scaleY, float scaleZ) {
+        return Mat4x4{
+            { scaleX,  0,       0,       0 },
+            { 0,       scaleY,  0,       0 },
+            { 0,       0,       scaleZ,  0 },
+            { 0,       0,       0,       1 }
+        };
+    }
     // Матрица вращения вокруг оси X
     static Mat4x4 rotationX(float angle);
     // Матрица вращения вокруг оси Y
     static Mat4x4 rotationY(float angle);
     // Матрица вращения вокруг оси Z
     static Mat4x4 rotationZ(float angle);
-    // Матрица проекции
+    // Матрица перспективной проекции по масштабу угла обзора (1 / tan(fov / 2))
+    static constexpr Mat4x4 perspective(float fNear, float fFar, float fFovScale, float fAspectRatio) {
+        return Mat4x4{
+            { fAspectRatio * fFovScale,  0,          0,                                 0 },
+            { 0,                         fFovScale,  0,                                 0 },
+            { 0,                         0,          fFar / (fFar - fNear),             1 },
+            { 0,                         0,          (-fFar * fNear) / (fFar - fNear),  0 }
+        };
+    }
+    // Матрица проекции (по углу обзора в градусах; тангенс не вычисляется при компиляции)
     static Mat4x4 projection(float fNear, float fFar, float fFov, float fAspectRatio);
     // Матрица "наведения"
     static Mat4x4 pointAt(const Vec3d& pos, const Vec3d& target, const Vec3d& up);
     // Обратная матрица
     static Mat4x4 inverse(const Mat4x4& m);
-};
\ No newline at end of file
+};
+
+static_assert(sizeof(Mat4x4) == 64, "Mat4x4 must stay sixteen packed floats");
+
+// Умножение матриц (каждая строка результата — комбинация строк правой матрицы)
+inline Mat4x4 Mat4x4::operator*(const Mat4x4& mat) const {
+    Mat4x4 result;
+    for (int i = 0; i < 4; ++i) {
+#if ENGINE_SSE
+        // Сумма начинается с нуля, как в скалярной версии: результат совпадает побитово (включая знак нуля)
+        __m128 r = _mm_setzero_ps();
+        r = _mm_add_ps(r, _mm_mul_ps(_mm_set1_ps(m[i][0]), mat.row(0)));
+        r = _mm_add_ps(r, _mm_mul_ps(_mm_set1_ps(m[i][1]), mat.row(1)));
+        r = _mm_add_ps(r, _mm_mul_ps(_mm_set1_ps(m[i][2]), mat.row(2)));
+        r = _mm_add_ps(r, _mm_mul_ps(_mm_set1_ps(m[i][3]), mat.row(3)));
+        _mm_store_ps(result.m[i].data(), r);
+#else
+        for (int j = 0; j < 4; ++j) {
+            result.m[i][j] = 0;
+            for (int k = 0; k < 4; ++k) {
+                result.m[i][j] += m[i][k] * mat.m[k][j];
+            }
+        }
+#endif
+    }
+    return result;
+}
@@ -0,0 +1,9 @@
+#pragma once
+
+// Наличие SSE (на x86-64 есть всегда); на других процессорах математика использует скалярные версии
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define ENGINE_SSE 1
+#else
+#define ENGINE_SSE 0
+#endif
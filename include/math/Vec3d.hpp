@@ -2,10 +2,12 @@
 
 #include <cmath>
 
+#include "math/Simd.hpp"
 #include "Mat4x4.hpp"
 
-// Класс для работы с 3D-вектором (x, y, z) и дополнительной компонентой w (для однородных координат)
-class Vec3d {
+// Класс для работы с 3D-вектором (x, y, z) и дополнительной компонентой w (для однородных координат).
+// Четыре компоненты выровнены по 16 байт и загружаются в один регистр SSE; все операции встраиваются
+class alignas(16) Vec3d {
 public:
 // 3D-координаты
     float x = 0, y = 0, z = 0;
@@ -13,53 +15,158 @@ public:
     float w = 1;
 
     // Конструктор по умолчанию
-    Vec3d() = default;
+    constexpr Vec3d() = default;
     // Конструктор с одинаковыми значениями для x, y, z
-    Vec3d(float xyz);
+    constexpr Vec3d(float xyz) : x(xyz), y(xyz), z(xyz) {}
     // Конструктор с отдельными значениями для x, y, z
-    Vec3d(float _x, float _y, float _z);
+    constexpr Vec3d(float _x, float _y, float _z) : x(_x), y(_y), z(_z) {}
 
     // Перегрузка стандартных операторов
-    Vec3d operator+(const Vec3d& other) const;
-    Vec3d operator-(const Vec3d& other) const;
-    Vec3d operator*(const Vec3d& other) const;
-    Vec3d operator/(const Vec3d& other) const;
+    Vec3d operator+(const Vec3d& other) const { return { x + other.x, y + other.y, z + other.z }; }
+    Vec3d operator-(const Vec3d& other) const { return { x - other.x, y - other.y, z - other.z }; }
+    Vec3d operator*(const Vec3d& other) const { return { x * other.x, y * other.y, z * other.z }; }
+    Vec3d operator/(const Vec3d& other) const { return { x / other.x, y / other.y, z / other.z }; }
 
-    Vec3d operator+(const float& f) const;
-    Vec3d operator-(const float& f) const;
-    Vec3d operator*(const float& f) const;
-    Vec3d operator/(const float& f) const;
+    Vec3d operator+(const float& f) const { return { x + f, y + f, z + f }; }
+    Vec3d operator-(const float& f) const { return { x - f, y - f, z - f }; }
+    Vec3d operator*(const float& f) const { return { x * f, y * f, z * f }; }
+    Vec3d operator/(const float& f) const { return { x / f, y / f, z / f }; }
 
     // Унарный минус (инверсия знака)
-    Vec3d operator-() const;
+    Vec3d operator-() const { return { -x, -y, -z }; }
 
     // Перегрузка опрераторов присваивания
-    Vec3d& operator+=(const Vec3d& other);
-    Vec3d& operator-=(const Vec3d& other);
-    Vec3d& operator*=(const Vec3d& other);
-    Vec3d& operator/=(const Vec3d& other);
+    Vec3d& operator+=(const Vec3d& other) { x += other.x; y += other.y; z += other.z; return *this; }
+    Vec3d& operator-=(const Vec3d& other) { x -= other.x; y -= other.y; z -= other.z; return *this; }
+    Vec3d& operator*=(const Vec3d& other) { x *= other.x; y *= other.y; z *= other.z; return *this; }
+    Vec3d& operator/=(const Vec3d& other) { x /= other.x; y /= other.y; z /= other.z; return *this; }
 
-    Vec3d& operator+=(const float& f);
-    Vec3d& operator-=(const float& f);
-    Vec3d& operator*=(const float& f);
-    Vec3d& operator/=(const float& f);
+    Vec3d& operator+=(const float& f) { x += f; y += f; z += f; return *this; }
+    Vec3d& operator-=(const float& f) { x -= f; y -= f; z -= f; return *this; }
+    Vec3d& operator*=(const float& f) { x *= f; y *= f; z *= f; return *this; }
+    Vec3d& operator/=(const float& f) { x /= f; y /= f; z /= f; return *this; }
 
     // Умножение вектора на матрицу 4x4
-    Vec3d operator*(const Mat4x4& mat);
+    Vec3d operator*(const Mat4x4& mat) const;
 
     // Векторное произведение
-    Vec3d cross(const Vec3d& other) const;  
+    Vec3d cross(const Vec3d& other) const;
     // Скалярное произведение
     float dot(const Vec3d& other) const;
 
     // Вычисление длины вектора
-    float length() const;
+    float length() const { return std::sqrt(dot(*this)); }
      // Нормализация вектора (приведение к длине 1)
     Vec3d normalize() const;
 
     // Деление x, y, z на w (для проекции)
-    void projectionDiv();
+    void projectionDiv() { x /= w; y /= w; z /= w; }
+    // Перевод x, y из нормализованных координат в пиксели буфера кадра (оси экрана направлены противоположно)
+    void scalingToDisplay(float width, float height) {
+        x = (1.f - x) * (0.5f * width);
+        y = (1.f - y) * (0.5f * height);
+    }
 
     // Вычисление ересечения линии с плоскостью
     void intersectPlane(const Vec3d& planePoint, const Vec3d& planeNormal, const Vec3d& lineStart, const Vec3d& lineEnd, float& t);
-};
\ No newline at end of file
+
+#if ENGINE_SSE
+    // Загрузка вектора в регистр и сохранение из регистра
+    __m128 load() const { return _mm_load_ps(&x); }
+    void store(__m128 value) { _mm_store_ps(&x, value); }
+#endif
+};
+
+static_assert(sizeof(Vec3d) == 16, "Vec3d must stay four packed floats");
+
+// Умножение вектора на матрицу 4x4 (порядок сложений тот же, что и в скалярной версии: результат совпадает побитово)
+inline Vec3d Vec3d::operator*(const Mat4x4& mat) const {
+    Vec3d result;
+#if ENGINE_SSE
+    __m128 r = _mm_mul_ps(_mm_set1_ps(x), mat.row(0));
+    r = _mm_add_ps(r, _mm_mul_ps(_mm_set1_ps(y), mat.row(1)));
+    r = _mm_add_ps(r, _mm_mul_ps(_mm_set1_ps(z), mat.row(2)));
+    r = _mm_add_ps(r, _mm_mul_ps(_mm_set1_ps(w), mat.row(3)));
+    result.store(r);
+#else
+    result.x = x * mat.m[0][0] + y * mat.m[1][0] + z * mat.m[2][0] + w * mat.m[3][0];
+    result.y = x * mat.m[0][1] + y * mat.m[1][1] + z * mat.m[2][1] + w * mat.m[3][1];
+    result.z = x * mat.m[0][2] + y * mat.m[1][2] + z * mat.m[2][2] + w * mat.m[3][2];
+    result.w = x * mat.m[0][3] + y * mat.m[1][3] + z * mat.m[2][3] + w * mat.m[3][3];
+#endif
+    return result;
+}
+
+// Векторное произведение
+inline Vec3d Vec3d::cross(const Vec3d& other) const {
+#if ENGINE_SSE
+    // (y, z, x) * (oz, ox, oy) - (z, x, y) * (oy, oz, ox)
+    __m128 a = load(), b = other.load();
+    __m128 aYZX = _mm_shuffle_ps(a, a, _MM_SHUFFLE(3, 0, 2, 1));
+    __m128 bZXY = _mm_shuffle_ps(b, b, _MM_SHUFFLE(3, 1, 0, 2));
+    __m128 aZXY = _mm_shuffle_ps(a, a, _MM_SHUFFLE(3, 1, 0, 2));
+    __m128 bYZX = _mm_shuffle_ps(b, b, _MM_SHUFFLE(3, 0, 2, 1));
+    Vec3d result;
+    result.store(_mm_sub_ps(_mm_mul_ps(aYZX, bZXY), _mm_mul_ps(aZXY, bYZX)));
+    // Результат — направление, а не точка
+    result.w = 1;
+    return result;
+#else
+    return { y * other.z - z * other.y, z * other.x - x * other.z, x * other.y - y * other.x };
+#endif
+}
+
+// Скалярное произведение
+inline float Vec3d::dot(const Vec3d& other) const {
+#if ENGINE_SSE
+    // Сумма (x + y) + z, как в скалярной версии
+    __m128 m = _mm_mul_ps(load(), other.load());
+    __m128 sum = _mm_add_ss(m, _mm_shuffle_ps(m, m, _MM_SHUFFLE(1, 1, 1, 1)));
+    sum = _mm_add_ss(sum, _mm_movehl_ps(m, m));
+    return _mm_cvtss_f32(sum);
+#else
+    return x * other.x + y * other.y + z * other.z;
+#endif
+}
+
+// Нормализация вектора
+inline Vec3d Vec3d::normalize() const {
+    // Вычисление длины
+    float len = length();
+    if (len > 0) {
+        // Возврат нормализованного вектора (точное деление, а не приближённый обратный корень)
+#if ENGINE_SSE
+        Vec3d result;
+        result.store(_mm_div_ps(load(), _mm_set1_ps(len)));
+        result.w = 1;
+        return result;
+#else
+        return { x / len, y / len, z / len };
+#endif
+    }
+    // Если длина нулевая, возвращаем нулевой вектор
+    return Vec3d(0);
+}
+
+// Пересечение линии с плоскостью
+inline void Vec3d::intersectPlane(const Vec3d& planePoint, const Vec3d& planeNormal, const Vec3d& lineStart, const Vec3d& lineEnd, float& t) {
+    // Нормализация нормали плоскости
+    Vec3d normalizedPlaneNormal = planeNormal.normalize();
+    // Вычисление расстояния до плоскости
+    float plane_d = -normalizedPlaneNormal.dot(planePoint);
+
+    // Скалярное произведение начала линии и нормали
+    float ad = lineStart.dot(normalizedPlaneNormal);
+    // Скалярное произведение конца линии и нормали
+    float bd = lineEnd.dot(normalizedPlaneNormal);
+
+    // Вычисление параметра t для точки пересечения
+    t = (-plane_d - ad) / (bd - ad);
+
+    // Вектор от начала до конца линии
+    Vec3d lineStartToEnd = lineEnd - lineStart;
+    // Вектор до точки пересечения
+    Vec3d lineToIntersect = lineStartToEnd * t;
+    // Результат — точка пересечения
+    *this = lineStart + lineToIntersect;
+}
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+#include "math/Simd.hpp"
+#include "math/Mat4x4.hpp"
+
+// Позиции вершин в виде структуры массивов (отдельный массив для каждой координаты)
+struct PositionStreams {
+    std::vector<float> x, y, z, w;
+
+    // Число вершин
+    std::size_t size() const { return x.size(); }
+    // Изменение числа вершин (память сохраняется между кадрами)
+    void resize(std::size_t count) {
+        x.resize(count);
+        y.resize(count);
+        z.resize(count);
+        w.resize(count);
+    }
+    // Резервирование памяти
+    void reserve(std::size_t count) {
+        x.reserve(count);
+        y.reserve(count);
+        z.reserve(count);
+        w.reserve(count);
+    }
+    // Удаление всех вершин
+    void clear() { resize(0); }
+    // Добавление вершины
+    void push(float vx, float vy, float vz, float vw = 1.f) {
+        x.push_back(vx);
+        y.push_back(vy);
+        z.push_back(vz);
+        w.push_back(vw);
+    }
+};
+
+// Класс для пакетной трансформации вершин: одна матрица применяется к целому потоку позиций,
+// по 4, 8 или 16 вершин за итерацию в зависимости от процессора. Результат совпадает побитово с Vec3d * Mat4x4
+class VertexTransform {
+public:
+    // Трансформация точек (w = 1) потока in в поток out (размер out подгоняется под in)
+    static void points(const Mat4x4& mat, const PositionStreams& in, PositionStreams& out);
+    // Трансформация точек из массивов x, y, z (w = 1) в массивы outX, outY, outZ, outW (могут совпадать с входными)
+    static void points(const Mat4x4& mat, const float* x, const float* y, const float* z, std::size_t count,
+                       float* outX, float* outY, float* outZ, float* outW);
+    // Трансформация квантованных точек: координата распаковывается как min + (origin + q) * step (так же, как
+    // в PackedMesh::decodePositions) небольшими блоками прямо перед трансформацией, без полного массива распакованных позиций
+    static void points(const Mat4x4& mat, const std::uint16_t* x, const std::uint16_t* y, const std::uint16_t* z, std::size_t count,
+                       const std::uint32_t origin[3], const float min[3], const float step[3],
+                       float* outX, float* outY, float* outZ, float* outW);
+};
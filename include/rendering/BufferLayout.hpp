@@ -0,0 +1,62 @@
+#pragma once
+
+#include <cstddef>
+#include <algorithm>
+
+#include "Config.hpp"
+
+// Класс для расположения пикселей буфера кадра в памяти: по строкам или плитками (квадрат tileSize x tileSize
+// пикселей лежит в памяти подряд, плитки идут по строкам плиток). Буферы кадра используют одно расположение,
+// поэтому индекс пикселя во всех буферах совпадает
+class BufferLayout {
+public:
+    // Размер плитки (степень двойки)
+    static constexpr int tileSize = glbl::render::tileSize;
+    static_assert(tileSize > 0 && (tileSize & (tileSize - 1)) == 0, "Tile size must be a power of two");
+
+    // Конструктор по умолчанию (пустой буфер)
+    BufferLayout() = default;
+    // Конструктор с заданием размеров и расположения
+    BufferLayout(int width, int height, bool tiled) :
+        m_width(width), m_height(height), m_tiled(tiled),
+        m_tilesPerRow((width + tileSize - 1) / tileSize), m_tileRows((height + tileSize - 1) / tileSize) {}
+
+    // Индекс пикселя (x, y) в памяти
+    int index(int x, int y) const {
+        if (!m_tiled) return y * m_width + x;
+        // Координаты неотрицательны: деление и остаток сводятся к сдвигам и маскам
+        unsigned ux = x, uy = y;
+        return static_cast<int>(((uy / tileSize) * m_tilesPerRow + ux / tileSize) * (tileSize * tileSize) + (uy % tileSize) * tileSize + ux % tileSize);
+    }
+
+    // Конец участка строки, который начинается в x и лежит в памяти подряд (не дальше end)
+    int runEnd(int x, int end) const { return m_tiled ? std::min(end, (x | (tileSize - 1)) + 1) : end; }
+
+    // Полоса — строки, которые лежат в памяти одним непрерывным блоком (строка пикселей или строка плиток).
+    // Полосы кадра, которые рисуют разные потоки, должны состоять из целых полос памяти
+    int stripHeight() const { return m_tiled ? tileSize : 1; }
+    int stripCount() const { return m_tiled ? m_tileRows : m_height; }
+    int strip(int y) const { return m_tiled ? static_cast<int>(static_cast<unsigned>(y) / tileSize) : y; }
+    // Число элементов в полосе памяти
+    std::size_t stripSize() const { return m_tiled ? static_cast<std::size_t>(m_tilesPerRow) * tileSize * tileSize : m_width; }
+
+    // Число элементов памяти (плитки на краях кадра дополняются до целых)
+    std::size_t size() const { return stripSize() * stripCount(); }
+
+    // Получение размеров и расположения
+    int width() const noexcept { return m_width; }
+    int height() const noexcept { return m_height; }
+    bool isTiled() const noexcept { return m_tiled; }
+
+    // Сравнение расположений
+    bool operator==(const BufferLayout& other) const { return m_width == other.m_width && m_height == other.m_height && m_tiled == other.m_tiled; }
+    bool operator!=(const BufferLayout& other) const { return !(*this == other); }
+
+private:
+    // Размеры буфера в пикселях
+    int m_width = 0, m_height = 0;
+    // Расположение плитками
+    bool m_tiled = false;
+    // Число плиток в строке плиток и число строк плиток
+    int m_tilesPerRow = 0, m_tileRows = 0;
+};
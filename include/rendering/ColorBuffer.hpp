@@ -0,0 +1,72 @@
+#pragma once
+
+#include <SFML/Graphics.hpp>
+#include <memory>
+#include <stdexcept>
+#include <algorithm>
+#include <cstdint>
+
+#include "rendering/BufferLayout.hpp"
+
+// Класс для работы с буфером цвета (кадр, который рендер рисует сам, а не через примитивы SFML)
+class ColorBuffer {
+public:
+    // Конструктор по умолчанию
+    ColorBuffer() = default;
+    // Конструктор с заданием размеров
+    ColorBuffer(int width, int height, bool tiled = false);
+
+    // Запрет копирования
+    ColorBuffer(const ColorBuffer&) = delete;
+    ColorBuffer& operator=(const ColorBuffer&) = delete;
+
+    // Разрешение перемещения
+    ColorBuffer(ColorBuffer&&) = default;
+    ColorBuffer& operator=(ColorBuffer&&) = default;
+
+    // Изменение размера и расположения буфера
+    void resize(int width, int height, bool tiled = false);
+
+    // Очистка буфера (заполнение прозрачным чёрным цветом)
+    void clear() noexcept;
+
+    // Запись цвета пикселя по индексу в памяти для растеризатора: без проверок (индекс проверяется только в отладочной сборке)
+    void setPixel(int index, const sf::Color& color) {
+#ifndef NDEBUG
+        validateCoordinates(index);
+#endif
+        std::uint8_t* pixel = m_colorBuffer.get() + static_cast<std::size_t>(index) * 4;
+        pixel[0] = color.r;
+        pixel[1] = color.g;
+        pixel[2] = color.b;
+        pixel[3] = 255;
+    }
+
+    // Доступ к пикселям в формате RGBA в порядке расположения буфера
+    // (при расположении по строкам — готовый кадр для загрузки в текстуру)
+    const std::uint8_t* data() const noexcept { return m_colorBuffer.get(); }
+    // Копирование строк [yBegin, yEnd) в кадр по строкам (out — width() * height() пикселей RGBA).
+    // Разные строки можно копировать из разных потоков
+    void resolve(std::uint8_t* out, int yBegin, int yEnd) const;
+
+    // Расположение пикселей в памяти
+    const BufferLayout& layout() const noexcept { return m_layout; }
+
+    // Получение размеров буфера
+    int width() const noexcept { return m_layout.width(); }
+    int height() const noexcept { return m_layout.height(); }
+
+private:
+    // Динамический массив для хранения цвета (по 4 байта RGBA на пиксель)
+    std::unique_ptr<std::uint8_t[]> m_colorBuffer;
+    // Размеры и расположение буфера
+    BufferLayout m_layout;
+    // Число пикселей, под которое выделена память
+    std::size_t m_capacity = 0;
+
+    // Валидация размеров буфера
+    void validateDimensions(int width, int height) const;
+
+    // Валидация индекса
+    void validateCoordinates(int index) const;
+};
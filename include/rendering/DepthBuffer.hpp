@@ -1,16 +1,24 @@
 #pragma once
 
 #include <memory>
+#include <cstddef>
+#include <cstdint>
 #include <stdexcept>
 #include <algorithm>
 
+#include "rendering/BufferLayout.hpp"
+
 // Класс для работы с буфером глубины (Z-буфер)
 class DepthBuffer {
 public:
+    // Режим очистки: заполнение всего буфера сразу или отложенная очистка
+    // (очистка только отмечает новый кадр, а полоса памяти заполняется при первом обращении к ней в этом кадре)
+    enum class ClearMode { Fill, Lazy };
+
     // Конструктор по умолчанию
     DepthBuffer() = default;
     // Конструктор с заданием размеров
-    DepthBuffer(int width, int height);
+    DepthBuffer(int width, int height, bool tiled = false);
 
     // Запрет копирования
     DepthBuffer(const DepthBuffer&) = delete;
@@ -20,31 +28,70 @@ public:
     DepthBuffer(DepthBuffer&&) = default;
     DepthBuffer& operator=(DepthBuffer&&) = default;
 
-    // Изменение размера буфера
-    void resize(int width, int height);
+    // Изменение размера и расположения буфера
+    void resize(int width, int height, bool tiled = false);
+
+    // Выбор режима очистки
+    void setClearMode(ClearMode mode);
+    ClearMode getClearMode() const noexcept { return m_lazyClear ? ClearMode::Lazy : ClearMode::Fill; }
 
     // Очистка буфера (заполнение значением по умолчанию 1.0)
     void clear(float value = 1.0f) noexcept;
 
-    // Доступ к элементам буфера по индексу
+    // Доступ к элементам буфера по индексу в памяти (с проверкой индекса)
     float& operator()(int index);
     const float& operator()(int index) const;
 
+    // Значение пикселя (x, y) для растеризатора: без проверок (координаты проверяются только в отладочной сборке).
+    // Подряд за ним лежат пиксели строки до layout().runEnd(x, ...). Разные полосы памяти можно запрашивать из разных потоков
+    float* at(int x, int y) {
+#ifndef NDEBUG
+        validatePixel(x, y);
+#endif
+        // При отложенной очистке полоса заполняется при первом обращении в кадре
+        if (m_lazyClear) {
+            int strip = m_layout.strip(y);
+            if (m_stripEpochs[strip] != m_epoch) clearStrip(strip);
+        }
+        return m_depthBuffer.get() + m_layout.index(x, y);
+    }
+
+    // Расположение пикселей в памяти
+    const BufferLayout& layout() const noexcept { return m_layout; }
+
     // Получение размеров буфера
-    int width() const noexcept { return m_width; }
-    int height() const noexcept { return m_height; }
+    int width() const noexcept { return m_layout.width(); }
+    int height() const noexcept { return m_layout.height(); }
 
 private:
 // Динамический массив для хранения значений глубины
     std::unique_ptr<float[]> m_depthBuffer;
-    // Ширина буфера
-    int m_width = 0;
-    // Высота буфера
-    int m_height = 0;
+    // Размеры и расположение буфера
+    BufferLayout m_layout;
+    // Число элементов, под которое выделена память
+    std::size_t m_capacity = 0;
+
+    // Отложенная очистка
+    bool m_lazyClear = false;
+    // Кадр, в котором была очищена каждая полоса памяти (только при отложенной очистке)
+    std::unique_ptr<std::uint32_t[]> m_stripEpochs;
+    // Число полос, под которое выделена память
+    int m_stripCapacity = 0;
+    // Номер текущего кадра очистки
+    std::uint32_t m_epoch = 0;
+    // Значение, которым заполняются полосы при отложенной очистке
+    float m_clearValue = 0.f;
+
+    // Заполнение полосы значением очистки
+    void clearStrip(int strip) noexcept;
+    // Выделение памяти под номера кадров полос
+    void reserveStrips();
 
     // Валидация размеров буфера
     void validateDimensions(int width, int height) const;
 
     // Валидация индекса
     void validateCoordinates(int index) const;
-};
\ No newline at end of file
+    // Валидация координат пикселя
+    void validatePixel(int x, int y) const;
+};
@@ -0,0 +1,50 @@
+#pragma once
+
+#include <SFML/Graphics.hpp>
+#include <vector>
+#include <cstdint>
+
+#include "math/Mat4x4.hpp"
+#include "math/Vec3d.hpp"
+#include "components/Camera.hpp"
+#include "components/geometry/Mesh.hpp"
+#include "components/geometry/MeshInstance.hpp"
+#include "components/lightning/Light.hpp"
+#include "components/props/Color.hpp"
+#include "rendering/RenderSettings.hpp"
+#include "scene/Scene.hpp"
+
+// Класс для снимка состояния кадра: всё, что нужно потоку рендера, без обращения к объектам основного потока
+class FrameSnapshot {
+public:
+    // Экземпляр модели в снимке
+    struct Item {
+        // Экземпляр, с которого снят снимок (только для сопоставления кэшей рендера, не разыменовывается)
+        const MeshInstance* owner;
+        // Общая геометрия (не меняется после загрузки)
+        const Mesh* mesh;
+        // Текстура экземпляра
+        sf::Image* texture;
+        // Оттенок экземпляра
+        Color tint;
+        bool tinted;
+        // Мировая и обратная мировая матрицы
+        Mat4x4 world, worldInverse;
+        // Флаг отражения
+        bool mirrored;
+        // Версия мировой матрицы
+        std::uint64_t version;
+    };
+
+    // Позиция и направление камеры
+    Vec3d cameraPos, cameraDir;
+    // Направление света
+    Vec3d lightDir;
+    // Настройки рендера на этот кадр
+    RenderSettings settings;
+    // Экземпляры в порядке списка отрисовки (память переиспользуется между кадрами)
+    std::vector<Item> items;
+
+    // Заполнение снимка текущим состоянием (вызывается в основном потоке после обновления сцены)
+    void capture(Camera& camera, const Scene& scene, Light& light, const RenderSettings& renderSettings);
+};
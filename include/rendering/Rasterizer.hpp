@@ -0,0 +1,41 @@
+#pragma once
+
+#include <SFML/Graphics.hpp>
+#include <algorithm>
+#include <cstdint>
+
+#include "Config.hpp"
+#include "components/geometry/Triangle.hpp"
+#include "components/props/Color.hpp"
+#include "rendering/DepthBuffer.hpp"
+#include "rendering/ColorBuffer.hpp"
+#include "rendering/VisibilityBuffer.hpp"
+
+// Класс для растеризации треугольников в буферы кадра
+class Rasterizer {
+public:
+    // Функция растеризации одного треугольника (конкретный вариант конвейера).
+    // Рисуются только строки [yMin, yMax], чтобы полосы кадра можно было растеризовать параллельно
+    using TriangleFunc = void (*)(const Triangle& triangle, DepthBuffer& depthBuffer, ColorBuffer& colorBuffer, const sf::Image* texture, int yMin, int yMax);
+
+    // Выбор варианта растеризатора под набор возможностей (выполняется один раз на пакет треугольников)
+    static TriangleFunc select(bool textured, bool depthTest, glbl::render::LightingMode lighting);
+
+    // Закрашивает ли треугольник хотя бы один пиксель. Растеризатор приводит вершины к целым, поэтому треугольник
+    // с нулевой площадью в целых координатах (в том числе с вершинами в одной строке или одном столбце) не рисуется
+    static bool coversPixels(const Triangle& triangle) {
+        int x1 = triangle.p[0].x, x2 = triangle.p[1].x, x3 = triangle.p[2].x;
+        int y1 = triangle.p[0].y, y2 = triangle.p[1].y, y3 = triangle.p[2].y;
+        return (x2 - x1) * (y3 - y1) != (x3 - x1) * (y2 - y1);
+    }
+
+    // Растеризация в буфер видимости (только глубина и идентификатор треугольника, без затенения)
+    static void visibilityTriangle(const Triangle& triangle, DepthBuffer& depthBuffer, VisibilityBuffer& visibilityBuffer, std::uint32_t id, int yMin, int yMax);
+
+    // Отсечение отрезка прямоугольником [0, width - 1] x [0, height - 1] (алгоритм Лианга — Барски).
+    // w концов (обратная глубина) линейна в экранных координатах и интерполируется вместе с x и y. false, если отрезок вне экрана
+    static bool clipLine(Vec3d& a, Vec3d& b, float width, float height);
+    // Растеризация отрезка внутри экрана (DDA) в строки [yMin, yMax] буфера цвета. При тесте глубины отрезок
+    // перекрывается гранями ближе него (с запасом glbl::render::edgeDepthBias), сам в буфер глубины не пишется
+    static void line(const Vec3d& a, const Vec3d& b, const sf::Color& color, DepthBuffer& depthBuffer, ColorBuffer& colorBuffer, bool depthTest, int yMin, int yMax);
+};
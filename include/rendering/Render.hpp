@@ -2,7 +2,8 @@
 
 #include <SFML/Graphics.hpp>
 #include <vector>
-#include <deque>
+#include <atomic>
+#include <cstdint>
 
 #include "Config.hpp"
 #include "math/Mat4x4.hpp"
@@ -10,32 +11,112 @@
 #include "components/geometry/Triangle.hpp"
 #include "components/Camera.hpp"
 #include "components/geometry/Mesh.hpp"
+#include "components/geometry/MeshInstance.hpp"
+#include "core/JobSystem.hpp"
+#include "core/StageProfiler.hpp"
+#include "rendering/FrameSnapshot.hpp"
 #include "components/lightning/Light.hpp"
 #include "rendering/DepthBuffer.hpp"
+#include "rendering/VisibilityBuffer.hpp"
+#include "rendering/ColorBuffer.hpp"
+#include "rendering/ResolutionScaler.hpp"
+#include "rendering/RenderSettings.hpp"
+#include "rendering/Rasterizer.hpp"
+#include "kernels/Kernels.hpp"
 
 // Класс для рендеринга 3D-сцены
 class Render {
 public:
-// Конструктор (принимает камеру)
-    Render(Camera& camera);
+// Конструктор (принимает планировщик задач)
+    Render(JobSystem& jobs);
 
-    // Добавление модели в список для рендеринга
-    void addMesh(Mesh& mesh);
+    // Отрисовка кадра по снимку состояния (вызывается в потоке рендера).
+    // Без цели (nullptr) кадр только растеризуется в буфер цвета — для прогонов без окна
+    void render(sf::RenderTarget* target, const FrameSnapshot& snapshot);
 
-    // Обновление матриц вида и проекции
-    void update();
-    // Отрисовка сцены
-    void render(sf::RenderWindow& window, Light light);
+    // Буфер цвета последнего кадра
+    const ColorBuffer& getColorBuffer() const { return m_colorBuffer; }
+
+    // Текущий масштаб внутреннего разрешения (можно читать из любого потока)
+    float getResolutionScale() const { return m_resolutionScale.load(std::memory_order_relaxed); }
 
 private:
-    // Список моделей для рендеринга
-    std::vector<Mesh*> m_renderMeshes;
-    // Камера (для вычисления матриц вида и проекции)
-    Camera& m_camera;
+    // Треугольник, записанный в буфер видимости (его индекс в списке и есть идентификатор)
+    struct VisibleTriangle {
+        // Треугольник в экранных координатах
+        Triangle triangle;
+        // Текстура модели (nullptr, если текстуры нет)
+        sf::Image* texture;
+        // Обратная удвоенная площадь (для восстановления барицентрических координат)
+        float invArea;
+    };
+
+    // Треугольники и кэш освещённости одного экземпляра (заполняются задачей этого экземпляра)
+    struct InstanceBatch {
+        // Экземпляр, для которого посчитана освещённость
+        const MeshInstance* owner = nullptr;
+        // Версия мировой матрицы и направление света, для которых посчитана освещённость
+        std::uint64_t version = 0;
+        Vec3d lightDir;
+        // Освещённость треугольников (пересчитывается только при изменении трансформации или света)
+        std::vector<float> illumination;
+
+        // Вершины всех треугольников модели в пространстве вида (пакетная трансформация)
+        PositionStreams view;
+        // Лежат ли вершины перед ближней плоскостью (пакетная классификация для отсечения)
+        std::vector<std::uint8_t> nearInside;
+        // Вершины треугольников после отсечения ближней плоскостью (проецируются одним пакетом)
+        PositionStreams clip;
+        // Треугольники после проекции
+        std::vector<Triangle> projected;
+        // Треугольники после отсечения по границам экрана
+        std::vector<Triangle> rendered;
+
+        // Видна ли грань модели (лицевая и не целиком за ближней плоскостью), только для каркасного режима
+        std::vector<std::uint8_t> faceVisible;
+        // Видимые рёбра модели в экранных координатах, отсечённые по границам экрана (по две точки на ребро, w — обратная глубина)
+        std::vector<Vec3d> edges;
+    };
+
+    // Планировщик задач (общий для всего движка)
+    JobSystem& m_jobs;
+    // Треугольники экземпляров текущего кадра (по индексу в снимке)
+    std::vector<InstanceBatch> m_instanceBatches;
+    // Настройки текущего кадра (берутся из снимка)
+    RenderSettings m_settings;
 
     // Матрицы вида и проекции
     Mat4x4 matView, matProj;
 
     // Буфер глубины для корректного отображения перекрытий
     DepthBuffer m_depthBuffer;
+
+    // Буфер видимости (идентификатор ближайшего треугольника для каждого пикселя)
+    VisibilityBuffer m_visibilityBuffer;
+    // Треугольники текущего кадра, попавшие в буфер видимости
+    std::vector<VisibleTriangle> m_visibleTriangles;
+    // Буфер цвета (внутренний кадр программной растеризации)
+    ColorBuffer m_colorBuffer;
+    // Текстура для вывода буфера цвета в окно
+    sf::Texture m_frameTexture;
+    // Кадр по строкам для загрузки в текстуру (только при расположении буферов плитками)
+    std::vector<std::uint8_t> m_framePixels;
+
+    // Регулятор внутреннего разрешения
+    ResolutionScaler m_resolutionScaler;
+
+    // Внутреннее разрешение текущего кадра
+    int m_renderWidth, m_renderHeight;
+    // Масштаб разрешения текущего кадра для чтения из основного потока
+    std::atomic<float> m_resolutionScale;
+
+    // Профилировщик стадий кадра
+    StageProfiler m_profiler;
+
+    // Обработка геометрии экземпляра (вызывается параллельно для разных экземпляров)
+    void processInstance(const FrameSnapshot::Item& item, Vec3d cameraPos, const Vec3d& lightDir, InstanceBatch& batch);
+    // Пересчёт освещённости треугольников экземпляра (если изменилась трансформация или направление света)
+    void updateIllumination(const FrameSnapshot::Item& item, const Vec3d& lightDir, InstanceBatch& batch);
+    // Проход затенения строк [yBegin, yEnd): однократная выборка текстуры для каждого видимого пикселя
+    void shadeVisibilityBuffer(int yBegin, int yEnd);
 };
\ No newline at end of file
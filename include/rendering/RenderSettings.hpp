@@ -0,0 +1,32 @@
+#pragma once
+
+#include "Config.hpp"
+
+// Настройки рендера, изменяемые во время работы (начальные значения берутся из glbl::render)
+class RenderSettings {
+public:
+    // Отображение текстур
+    bool textureVisible = glbl::render::textureVisible;
+    // Отображение "отвёрнутых" треугольников
+    bool backFaceVisible = glbl::render::backFaceVisible;
+    // Отображение треугольников (только в упрощённом рендере)
+    bool faceVisible = glbl::render::faceVisible;
+    // Отображение граней (только в упрощённом рендере)
+    bool edgeVisible = glbl::render::edgeVisible;
+    // Тест глубины
+    bool depthTest = glbl::render::depthTest;
+    // Режим освещения
+    glbl::render::LightingMode lighting = glbl::render::lighting;
+
+    // Упрощённый рендер
+    bool liteRender = glbl::render::liteRender;
+    // Буфер видимости
+    bool visibilityBuffer = glbl::render::visibilityBuffer;
+    // Расположение буферов кадра плитками
+    bool tiledBuffers = glbl::render::tiledBuffers;
+    // Динамическое разрешение
+    bool dynamicResolution = glbl::render::dynamicResolution;
+
+    // Профилирование стадий кадра
+    bool stageProfiling = glbl::profiling::stageProfiling;
+};
@@ -0,0 +1,27 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+
+// Класс для динамического масштабирования разрешения рендера под заданное время кадра
+class ResolutionScaler {
+public:
+    // Конструктор (целевое время растеризации в миллисекундах и минимальный масштаб)
+    ResolutionScaler(float targetTime, float minScale);
+
+    // Учёт измеренного времени растеризации кадра и подбор масштаба для следующего кадра
+    void update(float rasterTime);
+
+    // Текущий масштаб разрешения (от минимального до 1)
+    float getScale() const noexcept { return m_scale; }
+
+private:
+    // Целевое время растеризации (мс)
+    float m_targetTime;
+    // Минимально допустимый масштаб
+    float m_minScale;
+    // Текущий масштаб
+    float m_scale = 1.f;
+    // Сглаженное время растеризации (мс)
+    float m_averageTime = 0.f;
+};
@@ -0,0 +1,70 @@
+#pragma once
+
+#include <memory>
+#include <stdexcept>
+#include <algorithm>
+#include <cstdint>
+
+#include "rendering/BufferLayout.hpp"
+
+// Класс для работы с буфером видимости (идентификатор видимого треугольника для каждого пикселя)
+class VisibilityBuffer {
+public:
+    // Идентификатор пустого пикселя (ни один треугольник не попал)
+    static constexpr std::uint32_t emptyId = UINT32_MAX;
+
+    // Конструктор по умолчанию
+    VisibilityBuffer() = default;
+    // Конструктор с заданием размеров
+    VisibilityBuffer(int width, int height, bool tiled = false);
+
+    // Запрет копирования
+    VisibilityBuffer(const VisibilityBuffer&) = delete;
+    VisibilityBuffer& operator=(const VisibilityBuffer&) = delete;
+
+    // Разрешение перемещения
+    VisibilityBuffer(VisibilityBuffer&&) = default;
+    VisibilityBuffer& operator=(VisibilityBuffer&&) = default;
+
+    // Изменение размера и расположения буфера
+    void resize(int width, int height, bool tiled = false);
+
+    // Очистка буфера (заполнение идентификатором пустого пикселя)
+    void clear() noexcept;
+
+    // Доступ к элементам буфера по индексу в памяти
+    std::uint32_t& operator()(int index);
+    const std::uint32_t& operator()(int index) const;
+
+    // Идентификатор пикселя (x, y) для растеризатора: без проверок (координаты проверяются только в отладочной сборке).
+    // Подряд за ним лежат пиксели строки до layout().runEnd(x, ...)
+    std::uint32_t* at(int x, int y) {
+#ifndef NDEBUG
+        validatePixel(x, y);
+#endif
+        return m_visibilityBuffer.get() + m_layout.index(x, y);
+    }
+
+    // Расположение пикселей в памяти
+    const BufferLayout& layout() const noexcept { return m_layout; }
+
+    // Получение размеров буфера
+    int width() const noexcept { return m_layout.width(); }
+    int height() const noexcept { return m_layout.height(); }
+
+private:
+    // Динамический массив для хранения идентификаторов треугольников
+    std::unique_ptr<std::uint32_t[]> m_visibilityBuffer;
+    // Размеры и расположение буфера
+    BufferLayout m_layout;
+    // Число элементов, под которое выделена память
+    std::size_t m_capacity = 0;
+
+    // Валидация размеров буфера
+    void validateDimensions(int width, int height) const;
+
+    // Валидация индекса
+    void validateCoordinates(int index) const;
+    // Валидация координат пикселя
+    void validatePixel(int x, int y) const;
+};
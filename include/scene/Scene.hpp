@@ -0,0 +1,48 @@
+#pragma once
+
+#include <vector>
+#include <algorithm>
+
+#include "scene/SceneNode.hpp"
+#include "components/geometry/MeshInstance.hpp"
+
+// Класс для графа сцены: иерархия узлов, ленивый пересчёт мировых матриц и плоский список отрисовки
+class Scene {
+public:
+    // Конструктор
+    Scene();
+
+    // Запрет копирования и перемещения (узлы хранят указатель на сцену)
+    Scene(const Scene&) = delete;
+    Scene& operator=(const Scene&) = delete;
+
+    // Корневой узел сцены
+    SceneNode& getRoot();
+
+    // Добавление узла (к корню, если родитель не указан)
+    void addNode(SceneNode& node, SceneNode* parent = nullptr);
+    // Удаление узла вместе с поддеревом
+    void removeNode(SceneNode& node);
+
+    // Пересчёт изменившихся поддеревьев и (при изменении структуры) списка отрисовки
+    void update();
+
+    // Плоский список экземпляров для отрисовки (сгруппирован по общей геометрии)
+    const std::vector<MeshInstance*>& getRenderList() const;
+
+private:
+    // Корневой узел
+    SceneNode m_root;
+    // Узлы, трансформация которых изменилась с последнего обновления
+    std::vector<SceneNode*> m_dirtyNodes;
+    // Флаг изменения структуры графа (добавление или удаление узлов)
+    bool m_structureDirty = true;
+    // Список экземпляров для отрисовки
+    std::vector<MeshInstance*> m_renderList;
+
+    // Сбор экземпляров поддерева в список отрисовки
+    void collect(SceneNode& node);
+
+    // Узлы сообщают сцене об изменениях
+    friend class SceneNode;
+};
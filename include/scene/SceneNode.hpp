@@ -0,0 +1,83 @@
+#pragma once
+
+#include <vector>
+#include <cstdint>
+#include <atomic>
+#include <algorithm>
+
+#include "math/Mat4x4.hpp"
+#include "math/Vec3d.hpp"
+
+// Даём знать программе, что существует класс Scene (узел сообщает сцене об изменениях)
+class Scene;
+
+// Класс для узла графа сцены (локальная трансформация относительно родителя и кэш мировой матрицы)
+class SceneNode {
+public:
+    // Конструктор по умолчанию
+    SceneNode() = default;
+    // Деструктор (узел отсоединяется от родителя и детей)
+    virtual ~SceneNode();
+
+    // Запрет копирования (узлы связаны указателями)
+    SceneNode(const SceneNode&) = delete;
+    SceneNode& operator=(const SceneNode&) = delete;
+
+    // Добавление дочернего узла
+    void addChild(SceneNode& child);
+    // Удаление дочернего узла
+    void removeChild(SceneNode& child);
+
+    // Получение родительского узла
+    SceneNode* getParent() const;
+    // Получение дочерних узлов
+    const std::vector<SceneNode*>& getChildren() const;
+
+    // Перемещение узла
+    void translate(const Vec3d& offset);
+    // Масштабирование узла
+    void scale(const Vec3d& scale);
+    // Вращение узла
+    void rotate(const Vec3d& angle);
+
+    // Мировая матрица (актуальна после Scene::update)
+    const Mat4x4& getWorldMatrix() const;
+    // Обратная мировая матрица (из мирового пространства в пространство узла)
+    const Mat4x4& getWorldInverseMatrix() const;
+    // Проверка, отражён ли узел в мировом пространстве (с учётом всех родителей)
+    bool isWorldMirrored() const;
+    // Номер версии мировой матрицы (новый при каждом пересчёте, не повторяется между узлами)
+    std::uint64_t getWorldVersion() const;
+
+private:
+    // Сцена, в которую входит узел (nullptr, если узел не добавлен в сцену)
+    Scene* m_scene = nullptr;
+    // Родительский узел
+    SceneNode* m_parent = nullptr;
+    // Дочерние узлы
+    std::vector<SceneNode*> m_children;
+
+    // Позиция, масштаб и углы вращения относительно родителя
+    Vec3d m_position = Vec3d(0), m_scale = Vec3d(1), m_angle = Vec3d(0);
+
+    // Флаг, указывающий, что мировая матрица узла и его поддерева устарела
+    bool m_dirty = true;
+    // Мировая матрица
+    Mat4x4 m_matWorld = Mat4x4::scale(1, 1, 1);
+    // Обратная мировая матрица
+    Mat4x4 m_matWorldInverse = Mat4x4::scale(1, 1, 1);
+    // Флаг отражения в мировом пространстве
+    bool m_mirrored = false;
+    // Версия мировой матрицы
+    std::uint64_t m_worldVersion = 0;
+
+    // Пометка узла как изменённого (и регистрация в сцене)
+    void markDirty();
+    // Привязка поддерева к сцене
+    void setScene(Scene* scene);
+    // Пересчёт мировых матриц узла и всего поддерева
+    void updateWorld();
+
+    // Сцена управляет пересчётом узлов
+    friend class Scene;
+};
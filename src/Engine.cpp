@@ -1,22 +1,55 @@
 #include "Engine.hpp"
 
 // Конструктор
-Engine::Engine() :
-    // Вызываем конструктор создания окна
-    m_window(sf::VideoMode({glbl::window::width, glbl::window::height}), "3d render", sf::Style::Titlebar | sf::Style::Close),
+Engine::Engine(const EngineOptions& options) :
+    // Параметры запуска
+    m_options(options),
     // Пауза по умолчанию выключена
     m_isPaused(false),
-    // Курсор мыши заблокирован по умолчанию
-    m_isMouseLocked(true),
-    // Инициализация рендера с камерой
-    m_render(m_camera),
+    // Курсор мыши заблокирован по умолчанию (при воспроизведении мышь не управляет камерой)
+    m_isMouseLocked(options.replayPath.empty()),
+    // Инициализация рендера с планировщиком задач
+    m_render(m_jobs),
+    // Поток рендера запускается в run()
+    m_rendering(false),
+    m_renderedFrames(0),
     // Загрузка модели и текстуры
-    m_cube("resources/models/level.obj", "resources/textures/leveltexhigh.png")
+    m_cube("resources/models/level.obj", "resources/textures/leveltexhigh.png"),
+    // Экземпляр модели ссылается на загруженную геометрию
+    m_cubeInstance(m_cube),
+    m_replayTick(0),
+    m_traceDumps(0),
+    m_traceFramesDumped(false)
 {
-    // Скрытие курсора мыши, если он заблокирован
-    m_window.setMouseCursorVisible(!m_isMouseLocked);
-    // Вычисление центра окна
-    windowCenter = sf::Vector2i(m_window.getSize().x / 2, m_window.getSize().y / 2);
+    // Имя основного потока в трассе кадров
+    Trace::setThreadName("main");
+    // Трасса, которую нужно выгрузить после заданного числа кадров, записывается с первого кадра
+    if (m_options.traceFrames > 0) { Trace::setEnabled(true); }
+
+    // Размер геометрии модели в памяти
+    std::cout << "Model: " << m_cube.getTriangleCount() << " triangles, " << m_cube.getVertexCount() << " vertices, " << m_cube.getMemoryUsage() / 1024 << " KB"
+              << (m_cube.getPacked() ? " (packed)" : "") << std::endl;
+
+    // Окно создаётся только для прогона с выводом на экран
+    if (!m_options.headless) {
+        m_window.create(sf::VideoMode({glbl::window::width, glbl::window::height}), "3d render", sf::Style::Titlebar | sf::Style::Close);
+        // Скрытие курсора мыши, если он заблокирован
+        m_window.setMouseCursorVisible(!m_isMouseLocked);
+        // Вычисление центра окна
+        windowCenter = sf::Vector2i(m_window.getSize().x / 2, m_window.getSize().y / 2);
+    }
+
+    // Загрузка пути камеры для воспроизведения
+    if (!m_options.replayPath.empty()) {
+        m_cameraPath.load(m_options.replayPath);
+        if (m_cameraPath.getTickRate() != glbl::simulation::tickRate) {
+            // Путь, записанный с другой частотой шагов, воспроизводился бы с другой скоростью
+            throw std::runtime_error("Camera path was recorded at a different tick rate: " + m_options.replayPath);
+        }
+
+        // Нагрузка должна быть одинаковой в каждом прогоне: разрешение не подстраивается под скорость машины
+        m_renderSettings.dynamicResolution = false;
+    }
 
     // Скорость перемещения камеры
     m_cameraTranslateSpeed = 2;
@@ -24,28 +57,49 @@ Engine::Engine() :
     m_cameraRotateSpeed = 0.001;
 
     // Перемещение модели
-    m_cube.translate({0, 0, 2});
+    m_cubeInstance.translate({0, 0, 2});
     // Масштабирование модели
-    m_cube.scale({0.2, 0.2, 0.2});
-    // Добавление модели в рендерер
-    m_render.addMesh(m_cube);
+    m_cubeInstance.scale({0.2, 0.2, 0.2});
+    // Добавление экземпляра модели в сцену
+    m_scene.addNode(m_cubeInstance);
     // Установка направления света
     m_light.setDir({0.8, 1, -0.5});
 }
 
+// Деструктор
+Engine::~Engine() {
+    stopRenderThread();
+}
+
 // Основной цикл приложения
 void Engine::run() {
+    // Прогон без окна: только воспроизведение пути камеры
+    if (m_options.headless) {
+        runHeadless();
+        return;
+    }
+
     // Таймер для измерения времени
     sf::Clock clock;
-    // Время одного кадра
-    sf::Time frameTime = sf::seconds(1.f / glbl::window::frameRate);
+    // Ограничитель частоты основного цикла (опрос ввода и передача кадров)
+    FrameLimiter limiter(glbl::window::frameRate);
 
     // Время с последнего обновления FPS
     sf::Time elapsedTimeSinceLastUpdate = sf::Time::Zero;
+    // Число отрисованных кадров на момент последнего обновления FPS
+    unsigned int lastRenderedFrames = 0;
 
     // Установка курсора мыши в центр окна
     sf::Mouse::setPosition(windowCenter, m_window);
 
+    // Длительность шага симуляции
+    sf::Time step = sf::seconds(1.f / glbl::simulation::tickRate);
+    // Время, ещё не отработанное шагами симуляции
+    sf::Time accumulator = sf::Time::Zero;
+
+    // Отрисовка переносится в отдельный поток, основной поток обрабатывает ввод и обновляет сцену
+    startRenderThread();
+
     // Основной цикл
     while (m_window.isOpen()) {
         // Время, прошедшее с последнего кадра
@@ -58,32 +112,160 @@ void Engine::run() {
         // Пропуск обновления и отрисовки, если приложение на паузе
         if (m_isPaused) { continue; }
 
-        // Обновление состояния
-        update();
-        // Отрисовка сцены
-        draw();
+        // Накопление времени кадра (долгие кадры ограничиваются, чтобы симуляция не догоняла их бесконечно)
+        accumulator += std::min(deltaTime, sf::seconds(glbl::simulation::maxFrameTime));
+
+        // Симуляция выполняется шагами фиксированной длительности, сколько бы ни длился кадр
+        while (accumulator >= step && !isReplayFinished()) {
+            m_previousCamera = m_camera;
+            update(step.asSeconds());
+            accumulator -= step;
+        }
+
+        // Воспроизведение пути закончилось
+        if (isReplayFinished()) {
+            stopRenderThread();
+            m_window.close();
+            break;
+        }
+
+        // Передача кадра потоку рендера (состояние между двумя последними шагами)
+        submitFrame(accumulator / step);
+
+        // Выгрузка трассы после заданного числа кадров
+        if (m_options.traceFrames > 0 && !m_traceFramesDumped && m_renderedFrames >= m_options.traceFrames) {
+            dumpTrace();
+            m_traceFramesDumped = true;
+        }
 
         // Ограничение FPS
-        sf::Time elapsedTime = clock.getElapsedTime();
-        if (elapsedTime < frameTime) {
-            sf::sleep(frameTime - elapsedTime);
+        {
+            TRACE_SCOPE("main wait");
+            limiter.wait();
         }
 
         // Обновление заголовка окна (FPS)
         if (elapsedTimeSinceLastUpdate >= sf::seconds(0.05f)) {
-            float fps = 1.f / deltaTime.asSeconds(); 
-            m_window.setTitle("3d render - FPS: " + std::to_string(static_cast<int>(fps)));
+            // Частота кадров потока рендера (по числу кадров, отрисованных с прошлого обновления)
+            unsigned int renderedFrames = m_renderedFrames.load();
+            float fps = (renderedFrames - lastRenderedFrames) / elapsedTimeSinceLastUpdate.asSeconds();
+            lastRenderedFrames = renderedFrames;
+            // Текущий масштаб внутреннего разрешения (в процентах)
+            int scale = static_cast<int>(m_render.getResolutionScale() * 100.f);
+
+            // Хвост распределения времени кадров важнее среднего FPS
+            FrameStats::Summary stats;
+            AllocationTracker::Counts allocations;
+            {
+                std::lock_guard<std::mutex> lock(m_frameStatsMutex);
+                stats = m_frameStats;
+                allocations = m_frameAllocations;
+            }
+            std::ostringstream title;
+            title << std::fixed << std::setprecision(1)
+                  << "3d render - FPS: " << static_cast<int>(fps)
+                  << " - p50/p95/p99/max: " << stats.p50 << "/" << stats.p95 << "/" << stats.p99 << "/" << stats.max << " ms"
+                  << " - dropped: " << stats.dropped << " (" << stats.droppedTotal << ")"
+                  << " - scale: " << scale << "%";
+            if (AllocationTracker::enabled) {
+                title << " - allocs/frame: " << allocations.allocations << " (" << allocations.bytes / 1024 << " KB)";
+            }
+            m_window.setTitle(title.str());
             elapsedTimeSinceLastUpdate = sf::Time::Zero;
         }
     }
+
+    // Окно может закрыться и без события (например, при ошибке), поток рендера останавливается в любом случае
+    stopRenderThread();
+
+    // Сохранение записанного пути камеры
+    if (!m_options.recordPath.empty()) {
+        m_cameraPath.save(m_options.recordPath);
+        std::cout << "Camera path saved: " << m_options.recordPath << " (" << m_cameraPath.size() << " ticks)" << std::endl;
+    }
+}
+
+// Прогон без окна
+void Engine::runHeadless() {
+    // Длительность шага симуляции
+    float step = 1.f / glbl::simulation::tickRate;
+    // Статистика времени кадров за весь прогон
+    FrameStats stats(1000.f / glbl::window::frameRate, std::max<int>(1, static_cast<int>(m_cameraPath.size())));
+    // Снимок кадра (поток рендера не нужен: кадры рисуются по одному на шаг)
+    FrameSnapshot snapshot;
+
+    // Кадры рисуются в этом потоке: его выделения учитываются
+    AllocationTracker::trackCurrentThread();
+    // Выделения после разогрева (всего и наибольшее за кадр)
+    AllocationTracker::Counts steadyAllocations, maxFrameAllocations;
+
+    while (!isReplayFinished()) {
+        AllocationTracker::Counts allocationsBefore = AllocationTracker::get();
+
+        update(step);
+        snapshot.capture(m_camera, m_scene, m_light, m_renderSettings);
+
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        m_render.render(nullptr, snapshot);
+        stats.add(std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - start).count());
+
+        // Выделения памяти кадра (первые кадры разогревают буферы и не учитываются)
+        AllocationTracker::Counts frameAllocations = AllocationTracker::get() - allocationsBefore;
+        if (m_replayTick > glbl::profiling::allocationWarmupFrames) {
+            steadyAllocations += frameAllocations;
+            if (frameAllocations.allocations > maxFrameAllocations.allocations) { maxFrameAllocations = frameAllocations; }
+
+            if (m_options.assertNoAllocations && frameAllocations.allocations > 0) {
+                throw std::runtime_error("Frame " + std::to_string(m_replayTick) + " performed " + std::to_string(frameAllocations.allocations)
+                                         + " heap allocations (" + std::to_string(frameAllocations.bytes) + " bytes)");
+            }
+        }
+
+        // Выгрузка трассы после заданного числа кадров
+        if (m_options.traceFrames > 0 && m_replayTick == m_options.traceFrames) { dumpTrace(); }
+    }
+
+    FrameStats::Summary summary = stats.getSummary();
+    std::cout << std::fixed << std::setprecision(2)
+              << "frames: " << m_cameraPath.size()
+              << ", p50: " << summary.p50 << " ms, p95: " << summary.p95 << " ms, p99: " << summary.p99 << " ms, max: " << summary.max << " ms"
+              << ", over budget: " << summary.droppedTotal;
+    if (AllocationTracker::enabled) {
+        std::cout << ", steady-state allocations: " << steadyAllocations.allocations << " (" << steadyAllocations.bytes << " bytes)"
+                  << ", max per frame: " << maxFrameAllocations.allocations;
+    }
+    std::cout << std::endl;
+}
+
+// Выгрузка трассы кадров
+void Engine::dumpTrace() {
+    if (!Trace::isEnabled()) {
+        std::cout << "Frame tracing is disabled (enable it with --trace-frames)" << std::endl;
+        return;
+    }
+
+    std::string filename = "trace_" + std::to_string(m_traceDumps++) + ".json";
+    if (Trace::dump(filename)) {
+        std::cout << "Frame trace saved: " << filename << std::endl;
+    }
+    else {
+        std::cout << "Failed to save frame trace: " << filename << std::endl;
+    }
+}
+
+// Проверка, закончилось ли воспроизведение пути
+bool Engine::isReplayFinished() const {
+    return !m_options.replayPath.empty() && m_replayTick >= m_cameraPath.size();
 }
 
 // Обработка событий
 void Engine::handleEvents() {
+    TRACE_SCOPE("Engine::handleEvents");
     // Обработка всех событий в очереди
     while (const std::optional event = m_window.pollEvent()) {
-        // Закрытие окна
+        // Закрытие окна (поток рендера перестаёт пользоваться окном до его закрытия)
         if (event->is<sf::Event::Closed>()) {
+            stopRenderThread();
             m_window.close();
         }
 
@@ -106,11 +288,73 @@ void Engine::handleEvents() {
                 sf::Mouse::setPosition(windowCenter, m_window);
                 m_window.setMouseCursorVisible(!m_isMouseLocked);
             }
+
+            // Переключение режимов рендера без пересборки
+            RenderSettings& settings = m_renderSettings;
+            switch (eventKeyPressed->code) {
+            // Текстуры
+            case sf::Keyboard::Key::F1: settings.textureVisible = !settings.textureVisible; break;
+            // "Отвёрнутые" треугольники
+            case sf::Keyboard::Key::F2: settings.backFaceVisible = !settings.backFaceVisible; break;
+            // Упрощённый рендер
+            case sf::Keyboard::Key::F3: settings.liteRender = !settings.liteRender; break;
+            // Буфер видимости
+            case sf::Keyboard::Key::F4: settings.visibilityBuffer = !settings.visibilityBuffer; break;
+            // Тест глубины
+            case sf::Keyboard::Key::F5: settings.depthTest = !settings.depthTest; break;
+            // Освещение
+            case sf::Keyboard::Key::F6:
+                settings.lighting = (settings.lighting == glbl::render::LightingMode::Flat) ? glbl::render::LightingMode::Unlit : glbl::render::LightingMode::Flat;
+                break;
+            // Динамическое разрешение
+            case sf::Keyboard::Key::F7: settings.dynamicResolution = !settings.dynamicResolution; break;
+            // Треугольники и рёбра в упрощённом рендере
+            case sf::Keyboard::Key::F8: settings.faceVisible = !settings.faceVisible; break;
+            case sf::Keyboard::Key::F9: settings.edgeVisible = !settings.edgeVisible; break;
+            // Профилирование стадий кадра
+            case sf::Keyboard::Key::F10: settings.stageProfiling = !settings.stageProfiling; break;
+            // Выгрузка трассы кадров
+            case sf::Keyboard::Key::F11: dumpTrace(); break;
+            // Расположение буферов кадра плитками
+            case sf::Keyboard::Key::F12: settings.tiledBuffers = !settings.tiledBuffers; break;
+            default: break;
+            }
         }
     }
 
+    // Смещение мыши копится до следующего шага симуляции
+    if (m_isMouseLocked) {
+        m_mouseDelta += sf::Mouse::getPosition(m_window) - windowCenter;
+
+        // Возврат курсора в центр окна
+        sf::Mouse::setPosition(windowCenter, m_window);
+    }
+}
+
+// Шаг симуляции
+void Engine::update(float dt) {
+    TRACE_SCOPE("Engine::update");
+    if (!m_options.replayPath.empty()) {
+        // Воспроизведение: камера берётся из записанного пути, ввод игнорируется
+        m_cameraPath.apply(m_replayTick++, m_camera);
+        m_mouseDelta = {0, 0};
+    }
+    else {
+        // Управление камерой с клавиатуры и мыши
+        moveCamera(dt);
+    }
+
+    // Запись пути камеры (по одному состоянию на шаг)
+    if (!m_options.recordPath.empty()) { m_cameraPath.record(m_camera); }
+
+    // Пересчёт изменившихся мировых матриц и списка отрисовки
+    m_scene.update();
+}
+
+// Управление камерой
+void Engine::moveCamera(float dt) {
     // Управление камерой с клавиатуры
-    float translateSpeed = m_cameraTranslateSpeed * deltaTime.asSeconds();
+    float translateSpeed = m_cameraTranslateSpeed * dt;
 
     // Вперёд
     if (sf::Keyboard::isKeyPressed(sf::Keyboard::Key::W)) { m_camera.translateForwardNoY(translateSpeed); }
@@ -125,35 +369,110 @@ void Engine::handleEvents() {
     // Вниз
     if (sf::Keyboard::isKeyPressed(sf::Keyboard::Key::LShift)) { m_camera.translateDown(translateSpeed); }
 
-    // Управление камерой мышью
-    if (m_isMouseLocked) {
-        sf::Vector2i mousePosition = sf::Mouse::getPosition(m_window);
-        sf::Vector2i delta = mousePosition - windowCenter;
+    // Управление камерой мышью (накопленное смещение применяется в одном шаге)
+    // Вращение по горизонтали
+    if (m_mouseDelta.x != 0) { m_camera.rotateHorizontal(m_mouseDelta.x * m_cameraRotateSpeed); }
+    // Вращение по вертикали
+    if (m_mouseDelta.y != 0) { m_camera.rotateVertical(-m_mouseDelta.y * m_cameraRotateSpeed); }
+    m_mouseDelta = {0, 0};
+}
 
-        // Вращение по горизонтали
-        if (delta.x != 0) { m_camera.rotateHorizontal(delta.x * m_cameraRotateSpeed); }
-        // Вращение по вертикали
-        if (delta.y != 0) { m_camera.rotateVertical(-delta.y * m_cameraRotateSpeed); }
+// Передача снимка кадра потоку рендера
+void Engine::submitFrame(float alpha) {
+    TRACE_SCOPE("Engine::submitFrame");
+    // Если поток рендера не успевает и очередь заполнена, кадр пропускается: ввод не ждёт отрисовку
+    FrameSnapshot* snapshot = m_snapshots.beginPush();
+    if (!snapshot) return;
 
-        // Возврат курсора в центр окна
-        sf::Mouse::setPosition(windowCenter, m_window);
+    // Камера между двумя последними шагами симуляции: движение плавное при любой частоте кадров
+    Camera camera = Camera::interpolate(m_previousCamera, m_camera, alpha);
+    snapshot->capture(camera, m_scene, m_light, m_renderSettings);
+    m_snapshots.endPush();
+}
+
+// Запуск потока рендера
+void Engine::startRenderThread() {
+    // Контекст окна может быть активен только в одном потоке
+    if (!m_window.setActive(false)) {
+        throw std::runtime_error("Failed to release window context");
     }
+
+    m_rendering = true;
+    m_renderThread = std::thread(&Engine::renderLoop, this);
 }
 
-// Обновление состояния
-void Engine::update() {
-    // Обновление рендера
-    m_render.update();
+// Остановка потока рендера
+void Engine::stopRenderThread() {
+    if (!m_renderThread.joinable()) return;
+
+    m_rendering = false;
+    m_renderThread.join();
 }
 
-// Отрисовка сцены
-void Engine::draw() {
-    // Очистка экрана
-    m_window.clear(sf::Color::Black);
+// Цикл потока рендера
+void Engine::renderLoop() {
+    Trace::setThreadName("render");
+    AllocationTracker::trackCurrentThread();
+    // Активация контекста окна в потоке рендера
+    if (!m_window.setActive(true)) {
+        glbl::debug("Failed to activate window context in render thread");
+        return;
+    }
 
-    // Отрисовка сцены
-    m_render.render(m_window, m_light);
+    // Ограничитель частоты вывода кадров
+    FrameLimiter limiter(glbl::window::frameRate);
+    // Статистика времени между выводом кадров
+    FrameStats stats(1000.f / glbl::window::frameRate);
+    std::chrono::steady_clock::time_point lastPresent = std::chrono::steady_clock::now();
+    // Выделения памяти рендера с последней публикации сводки
+    AllocationTracker::Counts allocations;
+
+    while (m_rendering) {
+        // Ожидание снимка от основного потока
+        if (!m_snapshots.front()) {
+            std::this_thread::sleep_for(std::chrono::microseconds(100));
+            continue;
+        }
+
+        // Устаревшие снимки пропускаются: рисуется самое свежее состояние
+        while (m_snapshots.size() > 1) { m_snapshots.pop(); }
+        const FrameSnapshot& snapshot = *m_snapshots.front();
+
+        // Очистка экрана
+        m_window.clear(sf::Color::Black);
+        // Отрисовка сцены
+        AllocationTracker::Counts allocationsBefore = AllocationTracker::get();
+        m_render.render(&m_window, snapshot);
+        allocations += AllocationTracker::get() - allocationsBefore;
+        // Снимок возвращается производителю сразу после отрисовки
+        m_snapshots.pop();
+
+        // Кадр выводится точно в свой срок
+        {
+            TRACE_SCOPE("present wait");
+            limiter.wait();
+        }
+        // Отображение кадра
+        {
+            TRACE_SCOPE("display");
+            m_window.display();
+        }
+
+        // Время между выводом соседних кадров (то, что видит пользователь)
+        std::chrono::steady_clock::time_point present = std::chrono::steady_clock::now();
+        stats.add(std::chrono::duration<float, std::milli>(present - lastPresent).count());
+        lastPresent = present;
+        m_renderedFrames++;
+
+        // Публикация сводки для заголовка окна (не каждый кадр, чтобы не конкурировать за блокировку)
+        if (m_renderedFrames % 16 == 0) {
+            std::lock_guard<std::mutex> lock(m_frameStatsMutex);
+            m_frameStats = stats.getSummary();
+            m_frameAllocations = {allocations.allocations / 16, allocations.bytes / 16};
+            allocations = {};
+        }
+    }
 
-    // Отображение кадра
-    m_window.display();
+    // Контекст освобождается, чтобы основной поток мог закрыть окно
+    (void)m_window.setActive(false);
 }
@@ -1,13 +1,80 @@
 #include <iostream>
+#include <string>
+#include <cstdlib>
+#include <climits>
 
 #include "Engine.hpp"
+#include "kernels/Kernels.hpp"
+
+// Вывод справки по аргументам командной строки
+void printUsage(const char* program) {
+    std::cerr << "Usage: " << program << " [--record <file>] [--replay <file> [--headless]] [--trace-frames <count>] [--assert-no-alloc] [--isa scalar|sse42|avx2|avx512]" << std::endl;
+}
 
 // Точка входа в программу
-int main() {
+int main(int argc, char* argv[]) {
+    // Разбор аргументов командной строки
+    EngineOptions options;
+    // Уровень набора инструкций для ядер из ENGINE_ISA или --isa (для проверки вариантов на одной машине)
+    const char* isa = std::getenv("ENGINE_ISA");
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg == "--record" && i + 1 < argc) { options.recordPath = argv[++i]; }
+        else if (arg == "--replay" && i + 1 < argc) { options.replayPath = argv[++i]; }
+        else if (arg == "--headless") { options.headless = true; }
+        else if (arg == "--assert-no-alloc") { options.assertNoAllocations = true; }
+        else if (arg == "--trace-frames" && i + 1 < argc) {
+            // Число кадров — положительное целое без лишних символов
+            char* end = nullptr;
+            const char* value = argv[++i];
+            unsigned long frames = std::strtoul(value, &end, 10);
+            if (*value < '0' || *value > '9' || *end != '\0' || frames == 0 || frames > UINT_MAX) {
+                printUsage(argv[0]);
+                return 1;
+            }
+            options.traceFrames = static_cast<unsigned int>(frames);
+        }
+        else if (arg == "--isa" && i + 1 < argc) { isa = argv[++i]; }
+        else {
+            printUsage(argv[0]);
+            return 1;
+        }
+    }
+
+    // Без окна нет ввода: такой прогон может только воспроизводить путь
+    if ((options.headless && options.replayPath.empty()) || (!options.recordPath.empty() && !options.replayPath.empty())) {
+        printUsage(argv[0]);
+        return 1;
+    }
+
+    // Проверка выделений памяти выполняется только в прогоне без окна и только в сборке с их подсчётом
+    if (options.assertNoAllocations && (!options.headless || !AllocationTracker::enabled)) {
+        std::cerr << "--assert-no-alloc requires --headless and a build with ENGINE_TRACK_ALLOCATIONS" << std::endl;
+        return 1;
+    }
+
+    // Выбор варианта ядер до запуска потоков: заданный уровень или наибольший, который поддерживает процессор
+    Kernels::Level level = Kernels::detect();
+    if (isa && *isa) {
+        if (!Kernels::parseLevel(isa, level)) {
+            printUsage(argv[0]);
+            return 1;
+        }
+        if (level > Kernels::detect()) {
+            std::cerr << "Instruction set " << isa << " is not supported by this CPU (best: " << Kernels::getName(Kernels::detect()) << ")" << std::endl;
+            return 1;
+        }
+    }
+    if (!Kernels::select(level)) {
+        std::cerr << "Kernels for " << Kernels::getName(level) << " are not built for this platform" << std::endl;
+        return 1;
+    }
+    std::cout << "CPU kernels: " << Kernels::getName(Kernels::getLevel()) << std::endl;
+
     // Создаём объект класса движка
-    Engine engine;
+    Engine engine(options);
     // Запускаем движок
     engine.run();
 
     return 0;
-}
\ No newline at end of file
+}
@@ -4,7 +4,7 @@
 Camera::Camera(Vec3d direction, Vec3d position) : dir(direction), pos(position) {}
 
 // Получение текущей позиции камеры
-Vec3d Camera::getPos() { return pos; }
+Vec3d Camera::getPos() const { return pos; }
 
 // Получение текущего направления камеры
 Vec3d Camera::getDir() { update(); return dir; }
@@ -37,9 +37,33 @@ void Camera::translateUp(float offset) { translateY(offset); }
 void Camera::translateDown(float offset) { translateY(-offset); }
 
 // Вращение по горизонтали (изменение угла fYaw)
-void Camera::rotateHorizontal(float offset) { fYaw += offset; }
+void Camera::rotateHorizontal(float offset) { fYaw += offset; update(); }
 // Вращение по вертикали (изменение угла fPitch)
-void Camera::rotateVertical(float offset) { fPitch += offset; }
+void Camera::rotateVertical(float offset) { fPitch += offset; update(); }
+
+// Получение угла поворота по горизонтали
+float Camera::getYaw() const { return fYaw; }
+// Получение угла поворота по вертикали
+float Camera::getPitch() const { return fPitch; }
+
+// Установка позиции и углов
+void Camera::setState(const Vec3d& position, float yaw, float pitch) {
+    pos = position;
+    fYaw = yaw;
+    fPitch = pitch;
+    update();
+}
+
+// Интерполяция состояния камеры
+Camera Camera::interpolate(const Camera& from, const Camera& to, float alpha) {
+    Camera result;
+    // Позиция и углы интерполируются линейно, направление вычисляется из углов
+    result.pos = from.pos + (to.pos - from.pos) * alpha;
+    result.fYaw = from.fYaw + (to.fYaw - from.fYaw) * alpha;
+    result.fPitch = from.fPitch + (to.fPitch - from.fPitch) * alpha;
+    result.update();
+    return result;
+}
 
 // Обновление направления камеры на основе углов fYaw и fPitch
 void Camera::update() {
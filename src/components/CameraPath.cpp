@@ -0,0 +1,80 @@
+#include "components/CameraPath.hpp"
+
+// Добавление текущего состояния камеры
+void CameraPath::record(const Camera& camera) {
+    Vec3d pos = camera.getPos();
+    m_frames.push_back({pos.x, pos.y, pos.z, camera.getYaw(), camera.getPitch()});
+}
+
+// Установка камеры в состояние заданного шага
+void CameraPath::apply(std::size_t index, Camera& camera) const {
+    const Frame& frame = m_frames[index];
+    camera.setState({frame.x, frame.y, frame.z}, frame.yaw, frame.pitch);
+}
+
+// Число записанных шагов
+std::size_t CameraPath::size() const { return m_frames.size(); }
+
+// Частота шагов записи
+int CameraPath::getTickRate() const { return m_tickRate; }
+
+// Сохранение пути в файл
+void CameraPath::save(const std::string& filename) const {
+    std::ofstream file(filename, std::ios::binary);
+    if (!file.is_open()) {
+        // Ошибка, если файл не открылся
+        throw std::runtime_error("Failed to open camera path file for writing: " + filename);
+    }
+
+    // Заголовок: сигнатура, версия, частота шагов и число шагов, затем состояния подряд (по 20 байт)
+    std::uint32_t tickRate = static_cast<std::uint32_t>(m_tickRate);
+    std::uint32_t count = static_cast<std::uint32_t>(m_frames.size());
+    file.write(magic, sizeof(magic));
+    file.write(reinterpret_cast<const char*>(&version), sizeof(version));
+    file.write(reinterpret_cast<const char*>(&tickRate), sizeof(tickRate));
+    file.write(reinterpret_cast<const char*>(&count), sizeof(count));
+    file.write(reinterpret_cast<const char*>(m_frames.data()), m_frames.size() * sizeof(Frame));
+
+    if (!file) {
+        // Ошибка, если запись не удалась
+        throw std::runtime_error("Failed to write camera path file: " + filename);
+    }
+}
+
+// Загрузка пути из файла
+void CameraPath::load(const std::string& filename) {
+    std::ifstream file(filename, std::ios::binary);
+    if (!file.is_open()) {
+        // Ошибка, если файл не открылся
+        throw std::runtime_error("Failed to open camera path file: " + filename);
+    }
+
+    char fileMagic[4];
+    std::uint32_t fileVersion = 0, tickRate = 0, count = 0;
+    file.read(fileMagic, sizeof(fileMagic));
+    file.read(reinterpret_cast<char*>(&fileVersion), sizeof(fileVersion));
+    file.read(reinterpret_cast<char*>(&tickRate), sizeof(tickRate));
+    file.read(reinterpret_cast<char*>(&count), sizeof(count));
+    if (!file || std::memcmp(fileMagic, magic, sizeof(magic)) != 0 || fileVersion != version || tickRate == 0) {
+        // Ошибка, если это не файл пути камеры или он другой версии
+        throw std::runtime_error("Invalid camera path file: " + filename);
+    }
+
+    // Число кадров из заголовка проверяется по размеру файла до выделения памяти под них
+    std::streamoff dataBegin = file.tellg();
+    file.seekg(0, std::ios::end);
+    std::streamoff remaining = file.tellg() - dataBegin;
+    file.seekg(dataBegin);
+    if (!file || static_cast<std::uint64_t>(count) * sizeof(Frame) > static_cast<std::uint64_t>(remaining)) {
+        // Ошибка, если файл обрезан или заголовок повреждён
+        throw std::runtime_error("Truncated camera path file: " + filename);
+    }
+
+    m_frames.resize(count);
+    file.read(reinterpret_cast<char*>(m_frames.data()), m_frames.size() * sizeof(Frame));
+    if (!file) {
+        // Ошибка, если файл обрезан
+        throw std::runtime_error("Truncated camera path file: " + filename);
+    }
+    m_tickRate = static_cast<int>(tickRate);
+}
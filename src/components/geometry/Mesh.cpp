@@ -1,38 +1,32 @@
 #include "components/geometry/Mesh.hpp"
 
 // Конструктор для загрузки модели без текстуры
-Mesh::Mesh(const std::string& modelFilename) {
+Mesh::Mesh(const std::string& modelFilename, Storage storage) : m_isPacked(storage == Storage::Packed) {
     // Загрузка модели
     loadModel(modelFilename);
-    // Инициализация параметров
-    init();
+    // Нормали и потоки позиций (или упаковка)
+    finalizeGeometry();
 }
 
 // Конструктор для загрузки модели с текстурой
-Mesh::Mesh(const std::string& modelFilename, const std::string& textureFilename) {
+Mesh::Mesh(const std::string& modelFilename, const std::string& textureFilename, Storage storage) : m_isPacked(storage == Storage::Packed) {
     // Загрузка модели
     loadModel(modelFilename);
     // Загрузка текстуры
     loadTexture(textureFilename);
-    // Инициализация параметров
-    init();
+    // Нормали и потоки позиций (или упаковка)
+    finalizeGeometry();
 }
 
-// Инициализация параметров модели
-void Mesh::init() {
-    // Позиция по умолчанию (0, 0, 0)
-    m_position = Vec3d(0);
-    // Масштаб по умолчанию (1, 1, 1)
-    m_scale = Vec3d(1);
-    // Углы вращения по умолчанию (0, 0, 0)
-    m_angle = Vec3d(0);
-}
+// Проверка, есть ли текстура у модели
+bool Mesh::isTextured() { return m_texture != nullptr; }
 
 // Получение текстуры модели
 sf::Image* Mesh::getTexture() { return m_texture; }
 
 // Загрузка модели из файла .obj
 void Mesh::loadModel(std::string filename) {
+    TRACE_SCOPE("Mesh::loadModel");
     std::ifstream file(filename);
     if (!file.is_open()) {
         // Ошибка, если файл не открылся
@@ -50,6 +44,7 @@ void Mesh::loadModel(std::string filename) {
 
 // Загрузка текстуры
 void Mesh::loadTexture(std::string filename) {
+    TRACE_SCOPE("Mesh::loadTexture");
     m_texture = new sf::Image;
     if (!m_texture->loadFromFile(filename)) {
         // Ошибка, если текстура не загрузилась
@@ -127,6 +122,98 @@ void Mesh::parseLine(std::string& line) {
     }
 }
 
+// Вычисление нормалей треугольников в пространстве модели
+void Mesh::computeNormals() {
+    m_normals.clear();
+    m_normals.reserve(m_triangles.size());
+    for (const auto& triangle : m_triangles) {
+        m_normals.emplace_back(triangle.getNormal());
+    }
+}
+
+// Заполнение потоков позиций вершин (без оптимизации у каждого треугольника три собственные вершины)
+void Mesh::buildPositionStreams() {
+    m_positions.clear();
+    m_indices.clear();
+    for (const auto& triangle : m_triangles) {
+        for (const auto& vertex : triangle.p) {
+            m_indices.push_back(static_cast<std::uint32_t>(m_positions.size()));
+            m_positions.push(vertex.x, vertex.y, vertex.z);
+        }
+    }
+}
+
+// Оптимизация порядка треугольников и вершин
+void Mesh::optimize() {
+    TRACE_SCOPE("Mesh::optimize");
+
+    // Одинаковые вершины объединяются, треугольники ссылаются на них по индексам
+    std::vector<std::uint32_t> indices;
+    std::vector<std::uint32_t> corners = MeshOptimizer::weld(m_triangles, indices);
+    std::vector<std::uint32_t> triangleOrder = MeshOptimizer::orderTriangles(indices, corners.size(), glbl::mesh::vertexCacheSize);
+
+    // Треугольники и их индексы в новом порядке
+    std::vector<Triangle> triangles;
+    triangles.reserve(m_triangles.size());
+    m_indices.clear();
+    m_indices.reserve(indices.size());
+    for (std::uint32_t old : triangleOrder) {
+        triangles.push_back(m_triangles[old]);
+        for (int j = 0; j < 3; j++) { m_indices.push_back(indices[old * 3 + j]); }
+    }
+
+    // Вершины в порядке первого использования: трансформированные вершины читаются почти последовательно
+    std::vector<std::uint32_t> vertexOrder = MeshOptimizer::orderVertices(m_indices, corners.size());
+    m_positions.clear();
+    m_positions.reserve(vertexOrder.size());
+    for (std::uint32_t old : vertexOrder) {
+        const Vec3d& p = m_triangles[corners[old] / 3].p[corners[old] % 3];
+        m_positions.push(p.x, p.y, p.z);
+    }
+
+    m_triangles.swap(triangles);
+}
+
+// Подготовка геометрии после загрузки
+void Mesh::finalizeGeometry() {
+    // Оптимизация выполняется при каждой загрузке, файл модели не меняется
+    if (glbl::mesh::optimizeOnLoad) { optimize(); }
+    else { buildPositionStreams(); }
+
+    if (!m_isPacked) {
+        // Вычисление нормалей и рёбер
+        computeNormals();
+        m_edges = MeshOptimizer::uniqueEdges(m_indices, m_positions);
+        return;
+    }
+
+    TRACE_SCOPE("Mesh::pack");
+    m_packed.build(m_triangles);
+
+    // Рёбра по распакованным вершинам упакованной модели (одна вершина разных фрагментов распаковывается
+    // в одну позицию, поэтому ребро на границе фрагментов тоже хранится один раз)
+    std::vector<std::uint32_t> packedIndices(m_packed.getTriangleCount() * 3);
+    for (std::size_t k = 0; k < m_packed.getTriangleCount(); k++) { m_packed.getCorners(k, &packedIndices[k * 3]); }
+    PositionStreams packedPositions;
+    m_packed.decodePositions(packedPositions);
+    m_edges = MeshOptimizer::uniqueEdges(packedIndices, packedPositions);
+
+    // Нормали считаются по распакованным треугольникам, чтобы отсечение задних граней и освещение
+    // соответствовали тому, что реально рисуется
+    m_normals.clear();
+    m_normals.reserve(m_packed.getTriangleCount());
+    for (std::size_t k = 0; k < m_packed.getTriangleCount(); k++) {
+        m_normals.emplace_back(m_packed.decodeTriangle(k).getNormal());
+    }
+
+    // Полная геометрия больше не нужна: память освобождается
+    std::vector<Triangle>().swap(m_triangles);
+    std::vector<Vec3d>().swap(m_vertices);
+    std::vector<Vec2d>().swap(m_textureCoords);
+    std::vector<std::uint32_t>().swap(m_indices);
+    m_positions = PositionStreams();
+}
+
 // Извлечение индекса вершины из токена
 int Mesh::extractVertexIndex(const std::string& token) {
     size_t pos = token.find('/');
@@ -148,43 +235,34 @@ int Mesh::extractTextureIndex(const std::string& token) {
     return std::stoi(token.substr(firstSlash + 1, secondSlash - firstSlash - 1)) - 1;
 }
 
-// Перемещение модели
-void Mesh::translate(const Vec3d& offset) {
-    m_position += offset;
-}
+// Число треугольников модели
+std::size_t Mesh::getTriangleCount() const { return m_isPacked ? m_packed.getTriangleCount() : m_triangles.size(); }
 
-// Масштабирование модели
-void Mesh::scale(const Vec3d& scale) {
-    m_scale *= scale;
-}
+// Число вершин модели
+std::size_t Mesh::getVertexCount() const { return m_isPacked ? m_packed.getVertexCount() : m_positions.size(); }
 
-// Вращение модели
-void Mesh::rotate(const Vec3d& angle) {
-    m_angle += angle;
-}
+// Получение треугольников модели
+const std::vector<Triangle>& Mesh::getTriangles() const { return m_triangles; }
 
-// Получение трансформированных треугольников модели
-std::vector<Triangle> Mesh::getTransformedTriangles() const {
-    Mat4x4 matTrans, matScl, matRot;
-
-    // Матрица перемещения
-    matTrans = Mat4x4::translation(m_position.x, m_position.y, m_position.z);
-    // Матрица масштабирования
-    matScl = Mat4x4::scale(m_scale.x, m_scale.y, m_scale.z);
-    // Матрица вращения
-    matRot = Mat4x4::rotationX(m_angle.x) * Mat4x4::rotationY(m_angle.y) * Mat4x4::rotationZ(m_angle.z);
-
-    std::vector<Triangle> transformedTriangles;
-    for (auto triangle : m_triangles) {
-        // Применение масштабирования
-        triangle *= matScl;
-        // Применение вращения
-        triangle *= matRot;
-        // Применение перемещения
-        triangle *= matTrans;
-        // Добавление трансформированного треугольника в конечный вектор
-        transformedTriangles.emplace_back(triangle);
-    }
+// Получение нормалей треугольников в пространстве модели
+const std::vector<Vec3d>& Mesh::getNormals() const { return m_normals; }
+
+// Получение позиций вершин треугольников
+const PositionStreams& Mesh::getPositions() const { return m_positions; }
 
-    return transformedTriangles;
-}
\ No newline at end of file
+// Получение индексов вершин треугольников
+const std::vector<std::uint32_t>& Mesh::getIndices() const { return m_indices; }
+
+// Получение упакованной модели
+const PackedMesh* Mesh::getPacked() const { return m_isPacked ? &m_packed : nullptr; }
+
+// Получение уникальных рёбер модели
+const std::vector<MeshEdge>& Mesh::getEdges() const { return m_edges; }
+
+// Память, занимаемая геометрией модели
+std::size_t Mesh::getMemoryUsage() const {
+    return m_triangles.capacity() * sizeof(Triangle) + m_vertices.capacity() * sizeof(Vec3d) + m_textureCoords.capacity() * sizeof(Vec2d)
+        + m_normals.capacity() * sizeof(Vec3d) + m_positions.x.capacity() * sizeof(float) * 4 + m_indices.capacity() * sizeof(std::uint32_t)
+        + m_edges.capacity() * sizeof(MeshEdge)
+        + (m_isPacked ? m_packed.getMemoryUsage() : 0);
+}
@@ -0,0 +1,25 @@
+#include "components/geometry/MeshInstance.hpp"
+
+// Конструктор
+MeshInstance::MeshInstance(Mesh& mesh) : m_mesh(&mesh) {}
+
+// Получение общей геометрии
+Mesh& MeshInstance::getMesh() const { return *m_mesh; }
+
+// Установка оттенка
+void MeshInstance::setTint(const Color& tint) {
+    m_tint = tint;
+    m_tinted = true;
+}
+
+// Получение оттенка
+const Color& MeshInstance::getTint() const { return m_tint; }
+
+// Проверка, задан ли оттенок
+bool MeshInstance::isTinted() const { return m_tinted; }
+
+// Замена текстуры модели
+void MeshInstance::setTexture(sf::Image* texture) { m_texture = texture; }
+
+// Получение текстуры экземпляра
+sf::Image* MeshInstance::getTexture() const { return m_texture ? m_texture : m_mesh->getTexture(); }
@@ -0,0 +1,192 @@
+#include "components/geometry/MeshOptimizer.hpp"
+
+#include <unordered_map>
+#include <array>
+#include <algorithm>
+#include <cstring>
+
+namespace {
+    // Ключ вершины: побитовые значения позиции и текстурных координат
+    using VertexKey = std::array<std::uint32_t, 5>;
+    // Ключ позиции вершины (без текстурных координат)
+    using PositionKey = std::array<std::uint32_t, 3>;
+
+    // Хэш ключа из побитовых значений
+    template<std::size_t N>
+    struct KeyHash {
+        std::size_t operator()(const std::array<std::uint32_t, N>& key) const {
+            std::size_t hash = 0;
+            for (std::uint32_t value : key) { hash = (hash ^ value) * 0x100000001b3ull; }
+            return hash;
+        }
+    };
+
+    // Побитовое значение числа (вершины совпадают, только если совпадают все биты)
+    std::uint32_t bits(float value) {
+        std::uint32_t result;
+        std::memcpy(&result, &value, sizeof(result));
+        return result;
+    }
+}
+
+// Объединение одинаковых вершин
+std::vector<std::uint32_t> MeshOptimizer::weld(const std::vector<Triangle>& triangles, std::vector<std::uint32_t>& indices) {
+    std::vector<std::uint32_t> corners;
+    std::unordered_map<VertexKey, std::uint32_t, KeyHash<5>> welded;
+    welded.reserve(triangles.size() * 3);
+
+    indices.clear();
+    indices.reserve(triangles.size() * 3);
+    for (std::size_t k = 0; k < triangles.size(); k++) {
+        for (int j = 0; j < 3; j++) {
+            const Vec3d& p = triangles[k].p[j];
+            const Vec2d& t = triangles[k].t[j];
+            VertexKey key = {bits(p.x), bits(p.y), bits(p.z), bits(t.u), bits(t.v)};
+
+            auto found = welded.emplace(key, static_cast<std::uint32_t>(corners.size()));
+            if (found.second) { corners.push_back(static_cast<std::uint32_t>(k * 3 + j)); }
+            indices.push_back(found.first->second);
+        }
+    }
+
+    return corners;
+}
+
+// Порядок треугольников (Tipsify)
+std::vector<std::uint32_t> MeshOptimizer::orderTriangles(const std::vector<std::uint32_t>& indices, std::size_t vertexCount, int cacheSize) {
+    std::size_t triangleCount = indices.size() / 3;
+    std::vector<std::uint32_t> order;
+    order.reserve(triangleCount);
+    if (triangleCount == 0) return order;
+
+    // Списки треугольников каждой вершины (смещения и общий массив)
+    std::vector<std::uint32_t> offsets(vertexCount + 1, 0);
+    for (std::uint32_t v : indices) { offsets[v + 1]++; }
+    for (std::size_t v = 0; v < vertexCount; v++) { offsets[v + 1] += offsets[v]; }
+    std::vector<std::uint32_t> adjacency(indices.size());
+    std::vector<std::uint32_t> fill(offsets.begin(), offsets.end() - 1);
+    for (std::size_t i = 0; i < indices.size(); i++) { adjacency[fill[indices[i]]++] = static_cast<std::uint32_t>(i / 3); }
+
+    // Число ещё не выведенных треугольников вершины
+    std::vector<int> live(vertexCount);
+    for (std::size_t v = 0; v < vertexCount; v++) { live[v] = static_cast<int>(offsets[v + 1] - offsets[v]); }
+    // Время попадания вершины в кэш (вершина в кэше, если с тех пор прошло не больше cacheSize)
+    std::vector<int> cacheTime(vertexCount, 0);
+    std::vector<bool> emitted(triangleCount, false);
+    // Стек недавно использованных вершин для выхода из тупика
+    std::vector<std::uint32_t> deadEnd;
+    deadEnd.reserve(indices.size());
+    std::vector<std::uint32_t> candidates;
+
+    int time = cacheSize + 1;
+    std::size_t cursor = 0;
+    long fan = 0;
+
+    while (fan >= 0) {
+        // Вывод всех оставшихся треугольников вокруг текущей вершины
+        candidates.clear();
+        for (std::uint32_t a = offsets[fan]; a < offsets[fan + 1]; a++) {
+            std::uint32_t t = adjacency[a];
+            if (emitted[t]) continue;
+
+            order.push_back(t);
+            emitted[t] = true;
+            for (int j = 0; j < 3; j++) {
+                std::uint32_t v = indices[t * 3 + j];
+                deadEnd.push_back(v);
+                candidates.push_back(v);
+                live[v]--;
+                // Вершина не в кэше: она загружается заново
+                if (time - cacheTime[v] > cacheSize) { cacheTime[v] = time++; }
+            }
+        }
+
+        // Следующая вершина: из соседних та, что дольше всех в кэше, но не вытеснится до конца своего веера
+        fan = -1;
+        int best = -1;
+        for (std::uint32_t v : candidates) {
+            if (live[v] <= 0) continue;
+            int priority = 0;
+            if (time - cacheTime[v] + 2 * live[v] <= cacheSize) { priority = time - cacheTime[v]; }
+            if (priority > best) {
+                best = priority;
+                fan = v;
+            }
+        }
+
+        // Тупик: недавно использованная вершина с оставшимися треугольниками или первая такая по номеру
+        while (fan < 0 && !deadEnd.empty()) {
+            std::uint32_t v = deadEnd.back();
+            deadEnd.pop_back();
+            if (live[v] > 0) { fan = v; }
+        }
+        while (fan < 0 && cursor < vertexCount) {
+            if (live[cursor] > 0) { fan = static_cast<long>(cursor); }
+            cursor++;
+        }
+    }
+
+    return order;
+}
+
+// Нумерация вершин по первому использованию
+std::vector<std::uint32_t> MeshOptimizer::orderVertices(std::vector<std::uint32_t>& indices, std::size_t vertexCount) {
+    constexpr std::uint32_t unassigned = UINT32_MAX;
+    std::vector<std::uint32_t> remap(vertexCount, unassigned);
+    std::vector<std::uint32_t> order;
+    order.reserve(vertexCount);
+
+    for (std::uint32_t& index : indices) {
+        if (remap[index] == unassigned) {
+            remap[index] = static_cast<std::uint32_t>(order.size());
+            order.push_back(index);
+        }
+        index = remap[index];
+    }
+
+    return order;
+}
+
+// Уникальные рёбра
+std::vector<MeshEdge> MeshOptimizer::uniqueEdges(const std::vector<std::uint32_t>& indices, const PositionStreams& positions) {
+    // Вершины с одинаковой позицией (на швах текстуры, без объединения при загрузке, на границах фрагментов
+    // упакованной модели) сводятся к первой из них: ребро определяется только связностью по позициям
+    std::unordered_map<PositionKey, std::uint32_t, KeyHash<3>> firstAt;
+    firstAt.reserve(positions.size());
+    std::vector<std::uint32_t> canonical(positions.size());
+    for (std::size_t v = 0; v < positions.size(); v++) {
+        PositionKey key = {bits(positions.x[v]), bits(positions.y[v]), bits(positions.z[v])};
+        canonical[v] = firstAt.emplace(key, static_cast<std::uint32_t>(v)).first->second;
+    }
+
+    // Рёбра всех треугольников: ключ — пара вершин (меньшая в старших разрядах), значение — треугольник
+    std::vector<std::pair<std::uint64_t, std::uint32_t>> halfEdges;
+    halfEdges.reserve(indices.size());
+    for (std::size_t i = 0; i < indices.size(); i++) {
+        std::uint32_t a = canonical[indices[i]], b = canonical[indices[i % 3 == 2 ? i - 2 : i + 1]];
+        if (a == b) continue;
+        std::uint64_t key = (static_cast<std::uint64_t>(std::min(a, b)) << 32) | std::max(a, b);
+        halfEdges.emplace_back(key, static_cast<std::uint32_t>(i / 3));
+    }
+    // После сортировки одинаковые рёбра идут подряд
+    std::sort(halfEdges.begin(), halfEdges.end());
+
+    std::vector<MeshEdge> edges;
+    edges.reserve(halfEdges.size() / 2 + 1);
+    for (std::size_t first = 0; first < halfEdges.size(); ) {
+        std::size_t last = first;
+        while (last < halfEdges.size() && halfEdges[last].first == halfEdges[first].first) { last++; }
+
+        // Соседние треугольники ребра парами
+        std::uint64_t key = halfEdges[first].first;
+        for (std::size_t k = first; k < last; k += 2) {
+            MeshEdge edge = {{static_cast<std::uint32_t>(key >> 32), static_cast<std::uint32_t>(key)}, {halfEdges[k].second, MeshEdge::noTriangle}};
+            if (k + 1 < last) { edge.triangles[1] = halfEdges[k + 1].second; }
+            edges.push_back(edge);
+        }
+        first = last;
+    }
+
+    edges.shrink_to_fit();
+    return edges;
+}
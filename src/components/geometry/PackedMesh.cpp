@@ -0,0 +1,165 @@
+#include "components/geometry/PackedMesh.hpp"
+
+#include <map>
+#include <array>
+#include <cmath>
+#include <algorithm>
+
+namespace {
+    // Наибольшее квантованное значение
+    constexpr float quantMax = 65535.f;
+
+    // Квантование значения с шагом step относительно min (с ограничением диапазона)
+    std::uint32_t quantize(float value, float min, float step, std::uint32_t limit) {
+        double q = std::round((static_cast<double>(value) - min) / step);
+        return static_cast<std::uint32_t>(std::clamp(q, 0.0, static_cast<double>(limit)));
+    }
+}
+
+// Упаковка треугольников
+void PackedMesh::build(const std::vector<Triangle>& triangles) {
+    constexpr std::size_t chunkTriangles = glbl::mesh::packedChunkTriangles;
+    // Индексы внутри фрагмента 16-битные: даже без общих вершин фрагмент должен в них умещаться
+    static_assert(chunkTriangles > 0 && chunkTriangles * 3 <= 65536, "Packed chunk vertices must fit into 16-bit indices");
+
+    m_chunks.clear();
+    m_x.clear(); m_y.clear(); m_z.clear();
+    m_u.clear(); m_v.clear();
+    m_indices.clear();
+    if (triangles.empty()) return;
+
+    // Границы модели
+    Vec3d posMax = triangles[0].p[0];
+    Vec2d uvMax = triangles[0].t[0];
+    m_posMin = posMax;
+    m_uvMin = uvMax;
+    for (const auto& triangle : triangles) {
+        for (int j = 0; j < 3; j++) {
+            m_posMin = Vec3d(std::min(m_posMin.x, triangle.p[j].x), std::min(m_posMin.y, triangle.p[j].y), std::min(m_posMin.z, triangle.p[j].z));
+            posMax = Vec3d(std::max(posMax.x, triangle.p[j].x), std::max(posMax.y, triangle.p[j].y), std::max(posMax.z, triangle.p[j].z));
+            m_uvMin = Vec2d(std::min(m_uvMin.u, triangle.t[j].u), std::min(m_uvMin.v, triangle.t[j].v));
+            uvMax = Vec2d(std::max(uvMax.u, triangle.t[j].u), std::max(uvMax.v, triangle.t[j].v));
+        }
+    }
+
+    // Шаг общей сетки позиций выбирается так, чтобы самый большой фрагмент уместился в 16 бит.
+    // Сетка общая для всей модели: вершина на границе двух фрагментов распаковывается в них одинаково, без щелей
+    Vec3d chunkExtent(0.f);
+    for (std::size_t first = 0; first < triangles.size(); first += chunkTriangles) {
+        std::size_t last = std::min(first + chunkTriangles, triangles.size());
+        Vec3d cmin = triangles[first].p[0], cmax = cmin;
+        for (std::size_t k = first; k < last; k++) {
+            for (int j = 0; j < 3; j++) {
+                const Vec3d& p = triangles[k].p[j];
+                cmin = Vec3d(std::min(cmin.x, p.x), std::min(cmin.y, p.y), std::min(cmin.z, p.z));
+                cmax = Vec3d(std::max(cmax.x, p.x), std::max(cmax.y, p.y), std::max(cmax.z, p.z));
+            }
+        }
+        chunkExtent = Vec3d(std::max(chunkExtent.x, cmax.x - cmin.x), std::max(chunkExtent.y, cmax.y - cmin.y), std::max(chunkExtent.z, cmax.z - cmin.z));
+    }
+    // Два шага запаса на округление начала фрагмента вниз и вершин до ближайшего шага
+    auto gridStep = [](float extent) { return extent > 0.f ? extent / (quantMax - 2.f) : 1.f; };
+    m_posStep = Vec3d(gridStep(chunkExtent.x), gridStep(chunkExtent.y), gridStep(chunkExtent.z));
+    m_uvStep = Vec2d(uvMax.u > m_uvMin.u ? (uvMax.u - m_uvMin.u) / quantMax : 1.f, uvMax.v > m_uvMin.v ? (uvMax.v - m_uvMin.v) / quantMax : 1.f);
+
+    m_indices.reserve(triangles.size() * 3);
+    for (std::size_t first = 0; first < triangles.size(); first += chunkTriangles) {
+        std::size_t last = std::min(first + chunkTriangles, triangles.size());
+
+        // Вершины на общей сетке (старшие разряды остаются в начале фрагмента)
+        std::vector<std::array<std::uint32_t, 3>> grid;
+        grid.reserve((last - first) * 3);
+        for (std::size_t k = first; k < last; k++) {
+            for (const auto& p : triangles[k].p) {
+                grid.push_back({quantize(p.x, m_posMin.x, m_posStep.x, UINT32_MAX),
+                                quantize(p.y, m_posMin.y, m_posStep.y, UINT32_MAX),
+                                quantize(p.z, m_posMin.z, m_posStep.z, UINT32_MAX)});
+            }
+        }
+
+        // Начало фрагмента — наименьшая вершина по каждой оси
+        Chunk chunk = {{grid[0][0], grid[0][1], grid[0][2]}, static_cast<std::uint32_t>(m_x.size()), 0};
+        for (const auto& g : grid) {
+            for (int a = 0; a < 3; a++) { chunk.origin[a] = std::min(chunk.origin[a], g[a]); }
+        }
+
+        // Одинаковые вершины (позиция и текстурные координаты) хранятся один раз
+        std::map<std::array<std::uint16_t, 5>, std::uint16_t> welded;
+        for (std::size_t k = first; k < last; k++) {
+            for (int j = 0; j < 3; j++) {
+                const auto& g = grid[(k - first) * 3 + j];
+                const Vec2d& t = triangles[k].t[j];
+                std::array<std::uint16_t, 5> key = {
+                    static_cast<std::uint16_t>(std::min<std::uint32_t>(g[0] - chunk.origin[0], 65535)),
+                    static_cast<std::uint16_t>(std::min<std::uint32_t>(g[1] - chunk.origin[1], 65535)),
+                    static_cast<std::uint16_t>(std::min<std::uint32_t>(g[2] - chunk.origin[2], 65535)),
+                    static_cast<std::uint16_t>(quantize(t.u, m_uvMin.u, m_uvStep.u, 65535)),
+                    static_cast<std::uint16_t>(quantize(t.v, m_uvMin.v, m_uvStep.v, 65535))
+                };
+
+                auto found = welded.find(key);
+                if (found == welded.end()) {
+                    found = welded.emplace(key, static_cast<std::uint16_t>(chunk.vertexCount++)).first;
+                    m_x.push_back(key[0]); m_y.push_back(key[1]); m_z.push_back(key[2]);
+                    m_u.push_back(key[3]); m_v.push_back(key[4]);
+                }
+                m_indices.push_back(found->second);
+            }
+        }
+
+        m_chunks.push_back(chunk);
+    }
+
+    // Лишняя память после сборки не нужна: модель больше не меняется
+    m_x.shrink_to_fit(); m_y.shrink_to_fit(); m_z.shrink_to_fit();
+    m_u.shrink_to_fit(); m_v.shrink_to_fit();
+}
+
+// Распаковка позиций всех вершин
+void PackedMesh::decodePositions(PositionStreams& out) const {
+    out.resize(getVertexCount());
+    for (const Chunk& chunk : m_chunks) {
+        std::uint32_t end = chunk.firstVertex + chunk.vertexCount;
+        for (std::uint32_t i = chunk.firstVertex; i < end; i++) {
+            // Номер шага на общей сетке считается в целых числах: одна и та же вершина разных фрагментов совпадает
+            out.x[i] = m_posMin.x + static_cast<float>(chunk.origin[0] + m_x[i]) * m_posStep.x;
+            out.y[i] = m_posMin.y + static_cast<float>(chunk.origin[1] + m_y[i]) * m_posStep.y;
+            out.z[i] = m_posMin.z + static_cast<float>(chunk.origin[2] + m_z[i]) * m_posStep.z;
+        }
+    }
+}
+
+// Трансформация позиций всех вершин
+void PackedMesh::transformPositions(const Mat4x4& mat, PositionStreams& out) const {
+    out.resize(getVertexCount());
+    const float min[3] = {m_posMin.x, m_posMin.y, m_posMin.z};
+    const float step[3] = {m_posStep.x, m_posStep.y, m_posStep.z};
+    for (const Chunk& chunk : m_chunks) {
+        std::uint32_t first = chunk.firstVertex;
+        VertexTransform::points(mat, &m_x[first], &m_y[first], &m_z[first], chunk.vertexCount, chunk.origin, min, step,
+                                &out.x[first], &out.y[first], &out.z[first], &out.w[first]);
+    }
+}
+
+// Распаковка треугольника
+Triangle PackedMesh::decodeTriangle(std::size_t triangle) const {
+    const Chunk& chunk = m_chunks[triangle / glbl::mesh::packedChunkTriangles];
+    std::uint32_t corners[3];
+    getCorners(triangle, corners);
+
+    Triangle result;
+    for (int j = 0; j < 3; j++) {
+        std::uint32_t i = corners[j];
+        result.p[j] = Vec3d(m_posMin.x + static_cast<float>(chunk.origin[0] + m_x[i]) * m_posStep.x,
+                            m_posMin.y + static_cast<float>(chunk.origin[1] + m_y[i]) * m_posStep.y,
+                            m_posMin.z + static_cast<float>(chunk.origin[2] + m_z[i]) * m_posStep.z);
+        result.t[j] = getTextureCoords(i);
+    }
+    return result;
+}
+
+// Занимаемая память
+std::size_t PackedMesh::getMemoryUsage() const {
+    return sizeof(*this) + m_chunks.capacity() * sizeof(Chunk)
+        + (m_x.capacity() + m_y.capacity() + m_z.capacity() + m_u.capacity() + m_v.capacity() + m_indices.capacity()) * sizeof(std::uint16_t);
+}
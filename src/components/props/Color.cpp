@@ -14,4 +14,9 @@ Color Color::operator*(float brightness) {
     }
     // Если яркость вне диапазона, возвращаем исходный цвет
     return { r, g, b };
-}
\ No newline at end of file
+}
+
+// Покомпонентное умножение на другой цвет
+Color Color::modulate(const Color& other) const {
+    return { r * other.r / 255.f, g * other.g / 255.f, b * other.b / 255.f };
+}
@@ -0,0 +1,50 @@
+#include "core/AllocationTracker.hpp"
+
+#include <new>
+#include <cstdlib>
+
+namespace {
+    // Отмечен ли текущий поток для подсчёта (простая переменная: доступна до любых выделений в потоке)
+    thread_local bool t_tracked = false;
+}
+
+std::atomic<std::uint64_t> AllocationTracker::s_allocations(0);
+std::atomic<std::uint64_t> AllocationTracker::s_bytes(0);
+
+// Включение подсчёта выделений текущего потока
+void AllocationTracker::trackCurrentThread(bool tracked) { t_tracked = tracked; }
+
+// Выделения отмеченных потоков с начала работы
+AllocationTracker::Counts AllocationTracker::get() {
+    return {s_allocations.load(std::memory_order_relaxed), s_bytes.load(std::memory_order_relaxed)};
+}
+
+// Учёт выделения
+void AllocationTracker::record(std::size_t bytes) {
+    if (!t_tracked) return;
+    s_allocations.fetch_add(1, std::memory_order_relaxed);
+    s_bytes.fetch_add(bytes, std::memory_order_relaxed);
+}
+
+#ifdef ENGINE_TRACK_ALLOCATIONS
+// Замена глобальных operator new/delete. Массивы и варианты без исключений по стандарту вызывают эти функции
+void* operator new(std::size_t size) {
+    AllocationTracker::record(size);
+    if (void* ptr = std::malloc(size ? size : 1)) return ptr;
+    throw std::bad_alloc();
+}
+
+void* operator new(std::size_t size, std::align_val_t align) {
+    AllocationTracker::record(size);
+    // Размер для aligned_alloc должен быть кратен выравниванию
+    std::size_t alignment = static_cast<std::size_t>(align);
+    std::size_t rounded = (size + alignment - 1) / alignment * alignment;
+    if (void* ptr = std::aligned_alloc(alignment, rounded ? rounded : alignment)) return ptr;
+    throw std::bad_alloc();
+}
+
+void operator delete(void* ptr) noexcept { std::free(ptr); }
+void operator delete(void* ptr, std::size_t) noexcept { std::free(ptr); }
+void operator delete(void* ptr, std::align_val_t) noexcept { std::free(ptr); }
+void operator delete(void* ptr, std::size_t, std::align_val_t) noexcept { std::free(ptr); }
+#endif
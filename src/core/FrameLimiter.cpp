@@ -0,0 +1,30 @@
+#include "core/FrameLimiter.hpp"
+
+// Конструктор
+FrameLimiter::FrameLimiter(float frameRate, float spinMs) :
+    m_period(std::chrono::duration_cast<Clock::duration>(std::chrono::duration<float>(1.f / frameRate))),
+    m_spin(std::chrono::duration_cast<Clock::duration>(std::chrono::duration<float, std::milli>(spinMs))),
+    m_deadline(Clock::now())
+{}
+
+// Ожидание срока следующего кадра
+void FrameLimiter::wait() {
+    // Срок следующего кадра отсчитывается от предыдущего срока, а не от момента пробуждения
+    m_deadline += m_period;
+
+    Clock::time_point now = Clock::now();
+    // Кадр опоздал: сроки сдвигаются, чтобы не выпускать следующие кадры пачкой
+    if (m_deadline <= now) {
+        m_deadline = now;
+        return;
+    }
+
+    // Грубое ожидание сном с запасом до срока
+    if (m_deadline - now > m_spin) {
+        std::this_thread::sleep_for(m_deadline - now - m_spin);
+    }
+
+    // Точное ожидание остатка в цикле. Поток уступает ядро на каждом шаге, чтобы не отнимать его
+    // у соседнего логического ядра, на котором работают рендер и рабочие потоки
+    while (Clock::now() < m_deadline) { std::this_thread::yield(); }
+}
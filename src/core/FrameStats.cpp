@@ -0,0 +1,59 @@
+#include "core/FrameStats.hpp"
+
+// Конструктор
+FrameStats::FrameStats(float budgetMs, int window) : m_samples(std::max(window, 1)), m_dropThreshold(budgetMs * 1.5f) {}
+
+// Добавление времени кадра
+void FrameStats::add(float frameMs) {
+    // Вытеснение самого старого кадра из окна
+    if (m_count == static_cast<int>(m_samples.size())) {
+        float oldest = m_samples[m_next];
+        m_histogram[bucket(oldest)]--;
+        if (oldest > m_dropThreshold) { m_dropped--; }
+    }
+    else {
+        m_count++;
+    }
+
+    m_samples[m_next] = frameMs;
+    m_next = (m_next + 1) % static_cast<int>(m_samples.size());
+    m_histogram[bucket(frameMs)]++;
+
+    if (frameMs > m_dropThreshold) {
+        m_dropped++;
+        m_droppedTotal++;
+    }
+}
+
+// Сводка по текущему окну
+FrameStats::Summary FrameStats::getSummary() const {
+    Summary summary;
+    if (m_count == 0) return summary;
+
+    // Максимум берётся из самих времён (гистограмма его огрубляет)
+    for (int i = 0; i < m_count; i++) { summary.max = std::max(summary.max, m_samples[i]); }
+
+    summary.p50 = std::min(percentile(0.50f), summary.max);
+    summary.p95 = std::min(percentile(0.95f), summary.max);
+    summary.p99 = std::min(percentile(0.99f), summary.max);
+    summary.dropped = m_dropped;
+    summary.droppedTotal = m_droppedTotal;
+    return summary;
+}
+
+// Корзина гистограммы
+int FrameStats::bucket(float frameMs) {
+    return std::clamp(static_cast<int>(frameMs / bucketMs), 0, bucketCount - 1);
+}
+
+// Время кадра для заданной доли окна
+float FrameStats::percentile(float fraction) const {
+    // Номер кадра в отсортированном окне, который должен уложиться в искомое время
+    unsigned int rank = static_cast<unsigned int>(std::ceil(fraction * m_count));
+    unsigned int seen = 0;
+    for (int i = 0; i < bucketCount; i++) {
+        seen += m_histogram[i];
+        if (seen >= rank) { return (i + 1) * bucketMs; }
+    }
+    return bucketCount * bucketMs;
+}
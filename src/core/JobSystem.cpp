@@ -0,0 +1,206 @@
+#include "core/JobSystem.hpp"
+
+#ifdef __linux__
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace {
+    // Планировщик, которому принадлежит место текущего потока
+    thread_local const JobSystem* t_owner = nullptr;
+    // Место текущего потока (индекс его очереди и пула)
+    thread_local unsigned int t_slot = 0;
+}
+
+// Конструктор
+JobSystem::JobSystem(unsigned int workerCount) : m_nextExternalSlot(0), m_running(true), m_pending(0) {
+    if (workerCount == 0) {
+        // Вызывающий поток тоже выполняет задачи, пока ждёт их завершения
+        unsigned int cores = std::thread::hardware_concurrency();
+        workerCount = cores > 1 ? cores - 1 : 1;
+    }
+
+    // Место 0 — поток, создавший планировщик, затем рабочие потоки, затем внешние потоки
+    m_slotCount = 1 + workerCount + externalThreads;
+    m_nextExternalSlot = 1 + workerCount;
+    m_queues = std::make_unique<Queue[]>(m_slotCount);
+    m_pools = std::make_unique<Pool[]>(m_slotCount);
+    for (unsigned int i = 0; i < m_slotCount; i++) {
+        m_pools[i].jobs = std::make_unique<Job[]>(capacity);
+    }
+
+    t_owner = this;
+    t_slot = 0;
+
+    m_workerThreadIds = std::make_unique<std::atomic<int>[]>(workerCount);
+    for (unsigned int i = 0; i < workerCount; i++) { m_workerThreadIds[i] = 0; }
+
+    m_workers.reserve(workerCount);
+    for (unsigned int i = 0; i < workerCount; i++) {
+        m_workers.emplace_back(&JobSystem::workerLoop, this, 1 + i);
+    }
+}
+
+// Деструктор
+JobSystem::~JobSystem() {
+    {
+        std::lock_guard<std::mutex> lock(m_sleepMutex);
+        m_running = false;
+    }
+    m_wake.notify_all();
+
+    for (auto& worker : m_workers) { worker.join(); }
+
+    if (t_owner == this) { t_owner = nullptr; }
+}
+
+// Число потоков, выполняющих задачи
+unsigned int JobSystem::getThreadCount() const { return static_cast<unsigned int>(m_workers.size()) + 1; }
+
+// Идентификаторы рабочих потоков в системе
+std::vector<int> JobSystem::getWorkerThreadIds() const {
+    std::vector<int> ids;
+    for (size_t i = 0; i < m_workers.size(); i++) {
+        // Поток, ещё не успевший запуститься, пропускается
+        if (int id = m_workerThreadIds[i].load()) { ids.push_back(id); }
+    }
+    return ids;
+}
+
+// Постановка задачи в очередь
+void JobSystem::run(Job* job) {
+    // Переполненная очередь не теряет задачу: она выполняется сразу
+    if (!push(slot(), job)) { execute(job); }
+}
+
+// Ожидание завершения задачи
+void JobSystem::wait(const Job* job) {
+    while (job->unfinished.load(std::memory_order_acquire) > 0) {
+        // Вместо простоя поток помогает выполнять задачи
+        if (Job* next = getJob()) { execute(next); }
+        else { std::this_thread::yield(); }
+    }
+}
+
+// Место текущего потока
+unsigned int JobSystem::slot() {
+    if (t_owner != this) {
+        // Поток впервые обращается к планировщику: ему выдаётся одно из мест для внешних потоков
+        unsigned int slot = m_nextExternalSlot.fetch_add(1);
+        if (slot >= m_slotCount) {
+            throw std::runtime_error("Too many threads submit jobs");
+        }
+        t_owner = this;
+        t_slot = slot;
+    }
+    return t_slot;
+}
+
+// Выделение задачи
+JobSystem::Job* JobSystem::allocate(Job* parent) {
+    // Задачи берутся из кольца по кругу. Задача, которая ещё не завершена (например, корневая задача долгого
+    // параллельного цикла), пропускается: её место занимать нельзя, пока её ждут
+    Pool& pool = m_pools[slot()];
+    Job* job = nullptr;
+    for (unsigned int i = 0; i < capacity && !job; i++) {
+        Job* candidate = &pool.jobs[pool.next++ & (capacity - 1)];
+        if (candidate->unfinished.load(std::memory_order_acquire) == 0) { job = candidate; }
+    }
+    if (!job) {
+        throw std::runtime_error("Job pool is exhausted");
+    }
+
+    job->parent = parent;
+    job->unfinished.store(1, std::memory_order_relaxed);
+    if (parent) { parent->unfinished.fetch_add(1, std::memory_order_relaxed); }
+    return job;
+}
+
+// Добавление задачи в очередь
+bool JobSystem::push(unsigned int slot, Job* job) {
+    {
+        Queue& queue = m_queues[slot];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        if (queue.tail - queue.head == capacity) return false;
+        queue.jobs[queue.tail++ & (capacity - 1)] = job;
+    }
+
+    // Пробуждение простаивающего рабочего потока (блокировка исключает потерю сигнала)
+    m_pending.fetch_add(1);
+    { std::lock_guard<std::mutex> lock(m_sleepMutex); }
+    m_wake.notify_one();
+    return true;
+}
+
+// Извлечение задачи со своей очереди
+JobSystem::Job* JobSystem::pop(unsigned int slot) {
+    Queue& queue = m_queues[slot];
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    if (queue.head == queue.tail) return nullptr;
+
+    // Последняя добавленная задача скорее всего ещё в кэше
+    m_pending.fetch_sub(1);
+    return queue.jobs[--queue.tail & (capacity - 1)];
+}
+
+// Извлечение задачи из чужой очереди
+JobSystem::Job* JobSystem::steal(unsigned int slot) {
+    Queue& queue = m_queues[slot];
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    if (queue.head == queue.tail) return nullptr;
+
+    // Самые старые задачи обычно самые крупные
+    m_pending.fetch_sub(1);
+    return queue.jobs[queue.head++ & (capacity - 1)];
+}
+
+// Поиск задачи
+JobSystem::Job* JobSystem::getJob() {
+    unsigned int own = slot();
+    if (Job* job = pop(own)) return job;
+
+    // Своя очередь пуста: обход остальных очередей, начиная с соседней
+    for (unsigned int i = 1; i < m_slotCount; i++) {
+        if (Job* job = steal((own + i) % m_slotCount)) return job;
+    }
+    return nullptr;
+}
+
+// Выполнение задачи
+void JobSystem::execute(Job* job) {
+    job->function(*job);
+    finish(job);
+}
+
+// Завершение задачи
+void JobSystem::finish(Job* job) {
+    // Родитель читается до уменьшения счётчика: завершённая задача сразу может быть выделена заново
+    Job* parent = job->parent;
+    if (job->unfinished.fetch_sub(1, std::memory_order_acq_rel) == 1 && parent) {
+        finish(parent);
+    }
+}
+
+// Цикл рабочего потока
+void JobSystem::workerLoop(unsigned int slot) {
+    t_owner = this;
+    t_slot = slot;
+
+#ifdef __linux__
+    m_workerThreadIds[slot - 1] = static_cast<int>(syscall(SYS_gettid));
+#endif
+    Trace::setThreadName("worker " + std::to_string(slot));
+    // Задачи выполняются в основном для рендера: их выделения учитываются
+    AllocationTracker::trackCurrentThread();
+
+    while (m_running) {
+        if (Job* job = getJob()) {
+            execute(job);
+        }
+        else {
+            // Очереди пусты: поток спит до появления новой задачи
+            std::unique_lock<std::mutex> lock(m_sleepMutex);
+            m_wake.wait(lock, [this] { return !m_running || m_pending > 0; });
+        }
+    }
+}
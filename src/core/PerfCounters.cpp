@@ -0,0 +1,124 @@
+#include "core/PerfCounters.hpp"
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <cerrno>
+#include <cstring>
+#endif
+
+namespace {
+#ifdef __linux__
+    // Тип и код события для perf_event_open
+    struct EventConfig {
+        std::uint32_t type;
+        std::uint64_t config;
+    };
+
+    // События в порядке PerfCounters::Event
+    const EventConfig eventConfigs[PerfCounters::EventCount] = {
+        {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES},
+        {PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS},
+        {PERF_TYPE_HW_CACHE, PERF_COUNT_HW_CACHE_L1D | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16)},
+        {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES},
+        {PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES},
+    };
+
+    // Открытие счётчика события для потока (-1 при ошибке)
+    int openCounter(const EventConfig& event, int threadId) {
+        perf_event_attr attr;
+        std::memset(&attr, 0, sizeof(attr));
+        attr.size = sizeof(attr);
+        attr.type = event.type;
+        attr.config = event.config;
+        // Считается только код пользователя: так счётчики доступны и без прав на профилирование ядра
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        // Время работы счётчика нужно для поправки, когда событий больше, чем аппаратных счётчиков
+        attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+        return static_cast<int>(syscall(SYS_perf_event_open, &attr, threadId, -1, -1, PERF_FLAG_FD_CLOEXEC));
+    }
+#endif
+}
+
+// Деструктор
+PerfCounters::~PerfCounters() { close(); }
+
+// Открытие счётчиков для потоков
+bool PerfCounters::open(const std::vector<int>& threadIds) {
+    close();
+
+#ifdef __linux__
+    for (int event = 0; event < EventCount; event++) {
+        for (int threadId : threadIds) {
+            int fd = openCounter(eventConfigs[event], threadId);
+            if (fd < 0) {
+                // Событие не поддерживается процессором или запрещено: остальные события всё равно полезны
+                if (m_error.empty()) { m_error = std::string(getName(static_cast<Event>(event))) + ": " + std::strerror(errno); }
+                continue;
+            }
+
+            m_counters.push_back({fd, static_cast<Event>(event)});
+            m_available[event] = true;
+        }
+    }
+
+    if (isOpen()) { m_error.clear(); }
+#else
+    (void)threadIds;
+    m_error = "hardware counters are only supported on Linux";
+#endif
+
+    return isOpen();
+}
+
+// Закрытие счётчиков
+void PerfCounters::close() {
+#ifdef __linux__
+    for (const Counter& counter : m_counters) { ::close(counter.fd); }
+#endif
+    m_counters.clear();
+    m_available.fill(false);
+}
+
+// Открыт ли хотя бы один счётчик
+bool PerfCounters::isOpen() const { return !m_counters.empty(); }
+
+// Доступно ли событие
+bool PerfCounters::isAvailable(Event event) const { return m_available[event]; }
+
+// Причина недоступности счётчиков
+const std::string& PerfCounters::getError() const { return m_error; }
+
+// Текущие значения событий
+PerfCounters::Values PerfCounters::read() const {
+    Values values{};
+
+#ifdef __linux__
+    for (const Counter& counter : m_counters) {
+        // Значение, время включения и время фактического счёта
+        std::uint64_t data[3];
+        if (::read(counter.fd, data, sizeof(data)) != sizeof(data) || data[2] == 0) continue;
+
+        // Счётчик работал не всё время: значение экстраполируется на всё время включения
+        double scaled = static_cast<double>(data[0]) * static_cast<double>(data[1]) / static_cast<double>(data[2]);
+        values[counter.event] += static_cast<std::uint64_t>(scaled);
+    }
+#endif
+
+    return values;
+}
+
+// Короткое имя события
+const char* PerfCounters::getName(Event event) {
+    switch (event) {
+    case Cycles: return "cycles";
+    case Instructions: return "instr";
+    case L1Misses: return "L1d miss";
+    case LlcMisses: return "LLC miss";
+    case BranchMisses: return "br miss";
+    default: return "?";
+    }
+}
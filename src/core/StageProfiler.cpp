@@ -0,0 +1,113 @@
+#include "core/StageProfiler.hpp"
+
+// Конструктор
+StageProfiler::StageProfiler(int reportInterval) : m_reportInterval(std::max(reportInterval, 1)) {}
+
+// Включение и выключение
+void StageProfiler::setEnabled(bool enabled, const std::vector<int>& threadIds) {
+    if (enabled == m_enabled) return;
+    m_enabled = enabled;
+    m_stages.clear();
+    m_frames = 0;
+
+    if (!enabled) {
+        m_counters.close();
+        return;
+    }
+
+    m_threadCount = threadIds.size();
+    if (!m_counters.open(threadIds)) {
+        // Профилирование продолжается без счётчиков: время стадий полезно и само по себе
+        std::cout << "Stage profiling: hardware counters unavailable (" << m_counters.getError() << "), timings only" << std::endl;
+    }
+}
+
+// Включено ли профилирование
+bool StageProfiler::isEnabled() const { return m_enabled; }
+
+// Начало кадра
+void StageProfiler::beginFrame() {
+    if (!m_enabled && !Trace::isEnabled()) return;
+
+    m_stageStart = Clock::now();
+    if (m_enabled) {
+        m_stageValues = m_counters.read();
+        m_stageAllocations = AllocationTracker::get();
+    }
+}
+
+// Завершение стадии
+void StageProfiler::endStage(const char* name) {
+    if (!m_enabled && !Trace::isEnabled()) return;
+
+    Clock::time_point now = Clock::now();
+    Trace::record(name, m_stageStart, now);
+    // Следующая стадия начинается там, где закончилась эта
+    Clock::time_point start = m_stageStart;
+    m_stageStart = now;
+    if (!m_enabled) return;
+
+    PerfCounters::Values values = m_counters.read();
+    AllocationTracker::Counts allocations = AllocationTracker::get();
+
+    // Стадии кадра каждый раз одни и те же, поиск по короткому списку
+    auto stage = std::find_if(m_stages.begin(), m_stages.end(), [name](const Stage& s) { return s.name == name; });
+    if (stage == m_stages.end()) {
+        m_stages.push_back({name, 0.0, {}, {}});
+        stage = m_stages.end() - 1;
+    }
+
+    stage->ms += std::chrono::duration<double, std::milli>(now - start).count();
+    for (int i = 0; i < PerfCounters::EventCount; i++) {
+        // Поправка на разделение счётчиков может дать небольшое уменьшение значения
+        if (values[i] > m_stageValues[i]) { stage->counters[i] += values[i] - m_stageValues[i]; }
+    }
+
+    stage->allocations += allocations - m_stageAllocations;
+
+    m_stageValues = values;
+    m_stageAllocations = allocations;
+}
+
+// Завершение кадра
+void StageProfiler::endFrame() {
+    if (!m_enabled) return;
+
+    if (++m_frames >= m_reportInterval) { report(); }
+}
+
+// Вывод отчёта
+void StageProfiler::report() {
+    std::ostringstream out;
+    out << std::fixed << std::setprecision(2) << "Stage profile (average over " << m_frames << " frames";
+    if (m_counters.isOpen()) { out << ", counters on " << m_threadCount << " threads"; }
+    out << "):\n";
+
+    for (const Stage& stage : m_stages) {
+        out << "  " << std::left << std::setw(10) << stage.name << std::right << std::setw(8) << stage.ms / m_frames << " ms";
+
+        for (int i = 0; i < PerfCounters::EventCount; i++) {
+            PerfCounters::Event event = static_cast<PerfCounters::Event>(i);
+            if (!m_counters.isAvailable(event)) continue;
+            // Значения в миллионах событий за кадр
+            out << "  " << PerfCounters::getName(event) << " " << std::setprecision(3) << stage.counters[i] / 1e6 / m_frames << "M";
+        }
+
+        // Инструкций за такт: низкое значение указывает на ожидание памяти
+        if (m_counters.isAvailable(PerfCounters::Cycles) && m_counters.isAvailable(PerfCounters::Instructions) && stage.counters[PerfCounters::Cycles] > 0) {
+            out << "  IPC " << std::setprecision(2) << static_cast<double>(stage.counters[PerfCounters::Instructions]) / stage.counters[PerfCounters::Cycles];
+        }
+
+        // Выделения памяти за кадр (только в сборке с подсчётом выделений)
+        if (AllocationTracker::enabled) {
+            out << "  allocs " << std::setprecision(1) << static_cast<double>(stage.allocations.allocations) / m_frames
+                << " (" << static_cast<double>(stage.allocations.bytes) / 1024.0 / m_frames << " KB)";
+        }
+        out << std::setprecision(2) << "\n";
+    }
+
+    std::cout << out.str() << std::flush;
+
+    m_stages.clear();
+    m_frames = 0;
+}
@@ -0,0 +1,97 @@
+#include "core/Trace.hpp"
+
+std::atomic<bool> Trace::s_enabled(glbl::profiling::tracing);
+const Trace::Clock::time_point Trace::s_epoch = Trace::Clock::now();
+std::mutex Trace::s_buffersMutex;
+std::vector<std::unique_ptr<Trace::ThreadBuffer>> Trace::s_buffers;
+
+// Включение и выключение записи
+void Trace::setEnabled(bool enabled) { s_enabled.store(enabled, std::memory_order_relaxed); }
+
+// Имя текущего потока
+void Trace::setThreadName(const std::string& name) {
+    ThreadBuffer& buffer = threadBuffer();
+    std::lock_guard<std::mutex> lock(s_buffersMutex);
+    buffer.name = name;
+}
+
+// Запись отрезка
+void Trace::record(const char* name, Clock::time_point start, Clock::time_point end) {
+    if (!isEnabled()) return;
+
+    ThreadBuffer& buffer = threadBuffer();
+    if (!buffer.events) {
+        // Кольцо выделяется при первой записи: потоки без записи в трассу память под него не занимают
+        std::unique_ptr<Event[]> events = std::make_unique<Event[]>(capacity);
+        std::lock_guard<std::mutex> lock(s_buffersMutex);
+        buffer.events = std::move(events);
+    }
+    std::uint64_t head = buffer.head.load(std::memory_order_relaxed);
+
+    // Самое старое событие перезаписывается; выгрузка узнаёт об этом по позиции записи
+    Event& event = buffer.events[head & (capacity - 1)];
+    event.name = name;
+    event.start = std::chrono::duration_cast<std::chrono::nanoseconds>(start - s_epoch).count();
+    event.duration = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+
+    buffer.head.store(head + 1, std::memory_order_release);
+}
+
+// Кольцо текущего потока
+Trace::ThreadBuffer& Trace::threadBuffer() {
+    thread_local ThreadBuffer* buffer = nullptr;
+    if (!buffer) {
+        // Регистрация кольца: блокировка только один раз на поток (события выделяются при первой записи)
+        std::unique_ptr<ThreadBuffer> created = std::make_unique<ThreadBuffer>();
+
+        std::lock_guard<std::mutex> lock(s_buffersMutex);
+        created->id = static_cast<int>(s_buffers.size()) + 1;
+        created->name = "thread " + std::to_string(created->id);
+        buffer = created.get();
+        s_buffers.push_back(std::move(created));
+    }
+    return *buffer;
+}
+
+// Выгрузка трассы
+bool Trace::dump(const std::string& filename) {
+    std::ofstream file(filename);
+    if (!file.is_open()) return false;
+
+    file << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+    bool first = true;
+
+    std::lock_guard<std::mutex> lock(s_buffersMutex);
+    for (const std::unique_ptr<ThreadBuffer>& buffer : s_buffers) {
+        // Имя потока
+        file << (first ? "" : ",\n") << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << buffer->id
+             << ",\"args\":{\"name\":\"" << buffer->name << "\"}}";
+        first = false;
+        // Поток ещё ничего не записывал
+        if (!buffer->events) continue;
+
+        // Потоки продолжают писать во время выгрузки: копируется окно событий, которое не могло быть перезаписано
+        std::uint64_t head = buffer->head.load(std::memory_order_acquire);
+        std::uint64_t begin = head > capacity ? head - capacity : 0;
+        std::vector<Event> events;
+        events.reserve(head - begin);
+        for (std::uint64_t i = begin; i < head; i++) { events.push_back(buffer->events[i & (capacity - 1)]); }
+
+        // События, которые поток успел перезаписать за время копирования, отбрасываются. Место after поток мог
+        // заполнять прямо во время копирования (позиция публикуется после записи), поэтому оно тоже не считается целым
+        std::uint64_t after = buffer->head.load(std::memory_order_acquire);
+        std::uint64_t valid = after + 1 > capacity ? after + 1 - capacity : 0;
+        std::size_t skip = valid > begin ? static_cast<std::size_t>(std::min(valid - begin, head - begin)) : 0;
+
+        for (std::size_t i = skip; i < events.size(); i++) {
+            const Event& event = events[i];
+            // Время в микросекундах (дробная часть сохраняет точность до наносекунд)
+            file << ",\n{\"name\":\"" << event.name << "\",\"ph\":\"X\",\"pid\":1,\"tid\":" << buffer->id
+                 << ",\"ts\":" << event.start / 1000 << "." << std::to_string(1000 + event.start % 1000).substr(1)
+                 << ",\"dur\":" << event.duration / 1000 << "." << std::to_string(1000 + event.duration % 1000).substr(1) << "}";
+        }
+    }
+
+    file << "\n]}\n";
+    return file.good();
+}
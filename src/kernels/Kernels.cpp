@@ -0,0 +1,169 @@
+#include "kernels/Kernels.hpp"
+
+#include <cstring>
+
+#if ENGINE_KERNELS_X86
+#ifdef _MSC_VER
+#include <intrin.h>
+#else
+#include <cpuid.h>
+#endif
+#endif
+
+namespace {
+    // Трансформация точек
+    void transformPoints(const float* m, const float* x, const float* y, const float* z, std::size_t count,
+                         float* outX, float* outY, float* outZ, float* outW) {
+        for (std::size_t i = 0; i < count; i++) {
+            // Координаты читаются до записи: поток можно трансформировать на месте
+            float vx = x[i], vy = y[i], vz = z[i];
+            outX[i] = vx * m[0] + vy * m[4] + vz * m[8] + m[12];
+            outY[i] = vx * m[1] + vy * m[5] + vz * m[9] + m[13];
+            outZ[i] = vx * m[2] + vy * m[6] + vz * m[10] + m[14];
+            outW[i] = vx * m[3] + vy * m[7] + vz * m[11] + m[15];
+        }
+    }
+
+    // Классификация точек относительно плоскости
+    void classifyPlane(const float* plane, const float* x, const float* y, const float* z, std::size_t count, std::uint8_t* inside) {
+        for (std::size_t i = 0; i < count; i++) {
+            inside[i] = (x[i] * plane[0] + y[i] * plane[1] + z[i] * plane[2]) - plane[3] >= 0;
+        }
+    }
+
+    // Заполнение массива 32-битным значением
+    void fill32(void* dst, std::uint32_t value, std::size_t count) {
+        unsigned char* bytes = static_cast<unsigned char*>(dst);
+        for (std::size_t i = 0; i < count; i++) { std::memcpy(bytes + i * 4, &value, 4); }
+    }
+
+    // Заполнение массива в обход кэша (без векторных инструкций — обычная запись)
+    void streamFill32(void* dst, std::uint32_t value, std::size_t count) { fill32(dst, value, count); }
+
+    // Отрезок строки буфера видимости
+    float visibilitySpan(float* depth, std::uint32_t* ids, int count, float startW, float endW, float t, float tStep, std::uint32_t id) {
+        for (int j = 0; j < count; j++) {
+            float w = (1.f - t) * startW + t * endW;
+            if (w > depth[j]) {
+                depth[j] = w;
+                ids[j] = id;
+            }
+            t += tStep;
+        }
+        return t;
+    }
+
+    // Выборка текстуры без фильтрации
+    void sampleNearest(const void* texels, unsigned int width, unsigned int height, const float* u, const float* v, std::size_t count, std::uint32_t* out) {
+        const unsigned char* bytes = static_cast<const unsigned char*>(texels);
+        float maxU = static_cast<float>(width - 1), maxV = static_cast<float>(height - 1);
+        for (std::size_t i = 0; i < count; i++) {
+            float su = u[i] * width, sv = v[i] * height;
+            unsigned int tu = static_cast<unsigned int>(su < 0.f ? 0.f : (maxU < su ? maxU : su));
+            unsigned int tv = static_cast<unsigned int>(sv < 0.f ? 0.f : (maxV < sv ? maxV : sv));
+            std::memcpy(&out[i], bytes + (static_cast<std::size_t>(tv) * width + tu) * 4, 4);
+        }
+    }
+
+#if ENGINE_KERNELS_X86
+    // Регистры EAX, EBX, ECX, EDX для листа CPUID
+    struct CpuidRegs { unsigned int eax = 0, ebx = 0, ecx = 0, edx = 0; };
+
+    CpuidRegs cpuid(unsigned int leaf, unsigned int subleaf) {
+        CpuidRegs regs;
+#ifdef _MSC_VER
+        int r[4];
+        __cpuidex(r, static_cast<int>(leaf), static_cast<int>(subleaf));
+        regs = {static_cast<unsigned int>(r[0]), static_cast<unsigned int>(r[1]), static_cast<unsigned int>(r[2]), static_cast<unsigned int>(r[3])};
+#else
+        __cpuid_count(leaf, subleaf, regs.eax, regs.ebx, regs.ecx, regs.edx);
+#endif
+        return regs;
+    }
+
+    // Регистры состояния, которые сохраняет операционная система (XCR0)
+    unsigned long long xgetbv() {
+#ifdef _MSC_VER
+        return _xgetbv(0);
+#else
+        unsigned int eax, edx;
+        __asm__ volatile("xgetbv" : "=a"(eax), "=d"(edx) : "c"(0));
+        return (static_cast<unsigned long long>(edx) << 32) | eax;
+#endif
+    }
+#endif
+
+    // Таблицы по уровням (nullptr — вариант не собран для этой платформы)
+    const KernelTable* tableFor(Kernels::Level level) {
+        switch (level) {
+        case Kernels::Scalar: return &kernels::scalar;
+#if ENGINE_KERNELS_X86
+        case Kernels::Sse42: return &kernels::sse42;
+        case Kernels::Avx2: return &kernels::avx2;
+        case Kernels::Avx512: return &kernels::avx512;
+#endif
+        default: return nullptr;
+        }
+    }
+
+    // Имена уровней в порядке Kernels::Level
+    const char* const levelNames[Kernels::LevelCount] = {"scalar", "sse42", "avx2", "avx512"};
+}
+
+// Скалярный вариант (для процессоров без вариантов и как эталон для остальных)
+const KernelTable kernels::scalar = {transformPoints, classifyPlane, fill32, streamFill32, visibilitySpan, sampleNearest};
+
+const KernelTable* Kernels::s_table = &kernels::scalar;
+Kernels::Level Kernels::s_level = Kernels::Scalar;
+
+// Определение уровня по CPUID
+Kernels::Level Kernels::detect() {
+#if ENGINE_KERNELS_X86
+    unsigned int maxLeaf = cpuid(0, 0).eax;
+    CpuidRegs leaf1 = cpuid(1, 0);
+
+    // SSE4.1 (смешивание по маске) и SSE4.2
+    if (!(leaf1.ecx & (1u << 19)) || !(leaf1.ecx & (1u << 20))) return Scalar;
+
+    // AVX требует поддержки процессора и сохранения регистров YMM операционной системой (OSXSAVE + XCR0)
+    bool osxsave = (leaf1.ecx & (1u << 27)) && (leaf1.ecx & (1u << 28));
+    if (!osxsave || maxLeaf < 7) return Sse42;
+    unsigned long long xcr0 = xgetbv();
+    if ((xcr0 & 0x6) != 0x6) return Sse42;
+
+    CpuidRegs leaf7 = cpuid(7, 0);
+    if (!(leaf7.ebx & (1u << 5))) return Sse42;
+
+    // AVX-512F и сохранение регистров масок и ZMM
+    if ((leaf7.ebx & (1u << 16)) && (xcr0 & 0xE0) == 0xE0) return Avx512;
+    return Avx2;
+#else
+    return Scalar;
+#endif
+}
+
+// Выбор уровня
+bool Kernels::select(Level level) {
+    const KernelTable* table = tableFor(level);
+    if (!table || level > detect()) return false;
+
+    s_table = table;
+    s_level = level;
+    return true;
+}
+
+// Имя уровня
+const char* Kernels::getName(Level level) {
+    return (level >= 0 && level < LevelCount) ? levelNames[level] : "?";
+}
+
+// Уровень по имени
+bool Kernels::parseLevel(const char* name, Level& level) {
+    for (int i = 0; i < LevelCount; i++) {
+        if (std::strcmp(name, levelNames[i]) == 0) {
+            level = static_cast<Level>(i);
+            return true;
+        }
+    }
+    return false;
+}
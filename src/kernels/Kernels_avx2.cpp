@@ -0,0 +1,125 @@
+#include "kernels/Kernels.hpp"
+
+// Вариант ядер для AVX2 (собирается с -mavx2 без FMA, вызывается только после проверки CPUID).
+// Кроме заголовка ядер здесь ничего не подключается, чтобы код с этими инструкциями не попал в общие функции
+#if ENGINE_KERNELS_X86
+#include <immintrin.h>
+
+namespace {
+    // Трансформация точек: по 8 вершин за итерацию
+    void transformPoints(const float* m, const float* x, const float* y, const float* z, std::size_t count,
+                         float* outX, float* outY, float* outZ, float* outW) {
+        __m256 m00 = _mm256_set1_ps(m[0]), m01 = _mm256_set1_ps(m[1]), m02 = _mm256_set1_ps(m[2]), m03 = _mm256_set1_ps(m[3]);
+        __m256 m10 = _mm256_set1_ps(m[4]), m11 = _mm256_set1_ps(m[5]), m12 = _mm256_set1_ps(m[6]), m13 = _mm256_set1_ps(m[7]);
+        __m256 m20 = _mm256_set1_ps(m[8]), m21 = _mm256_set1_ps(m[9]), m22 = _mm256_set1_ps(m[10]), m23 = _mm256_set1_ps(m[11]);
+        __m256 m30 = _mm256_set1_ps(m[12]), m31 = _mm256_set1_ps(m[13]), m32 = _mm256_set1_ps(m[14]), m33 = _mm256_set1_ps(m[15]);
+
+        std::size_t i = 0;
+        for (; i + 8 <= count; i += 8) {
+            __m256 vx = _mm256_loadu_ps(x + i), vy = _mm256_loadu_ps(y + i), vz = _mm256_loadu_ps(z + i);
+            _mm256_storeu_ps(outX + i, _mm256_add_ps(_mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(vx, m00), _mm256_mul_ps(vy, m10)), _mm256_mul_ps(vz, m20)), m30));
+            _mm256_storeu_ps(outY + i, _mm256_add_ps(_mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(vx, m01), _mm256_mul_ps(vy, m11)), _mm256_mul_ps(vz, m21)), m31));
+            _mm256_storeu_ps(outZ + i, _mm256_add_ps(_mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(vx, m02), _mm256_mul_ps(vy, m12)), _mm256_mul_ps(vz, m22)), m32));
+            _mm256_storeu_ps(outW + i, _mm256_add_ps(_mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(vx, m03), _mm256_mul_ps(vy, m13)), _mm256_mul_ps(vz, m23)), m33));
+        }
+        kernels::sse42.transformPoints(m, x + i, y + i, z + i, count - i, outX + i, outY + i, outZ + i, outW + i);
+    }
+
+    // Классификация точек относительно плоскости: по 8 точек за итерацию
+    void classifyPlane(const float* plane, const float* x, const float* y, const float* z, std::size_t count, std::uint8_t* inside) {
+        __m256 nx = _mm256_set1_ps(plane[0]), ny = _mm256_set1_ps(plane[1]), nz = _mm256_set1_ps(plane[2]), d = _mm256_set1_ps(plane[3]);
+
+        std::size_t i = 0;
+        for (; i + 8 <= count; i += 8) {
+            __m256 dist = _mm256_sub_ps(_mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(_mm256_loadu_ps(x + i), nx), _mm256_mul_ps(_mm256_loadu_ps(y + i), ny)), _mm256_mul_ps(_mm256_loadu_ps(z + i), nz)), d);
+            int mask = _mm256_movemask_ps(_mm256_cmp_ps(dist, _mm256_setzero_ps(), _CMP_GE_OQ));
+            for (int k = 0; k < 8; k++) { inside[i + k] = (mask >> k) & 1; }
+        }
+        kernels::sse42.classifyPlane(plane, x + i, y + i, z + i, count - i, inside + i);
+    }
+
+    // Заполнение массива: по 32 байта за запись
+    void fill32(void* dst, std::uint32_t value, std::size_t count) {
+        unsigned char* bytes = static_cast<unsigned char*>(dst);
+        __m256i v = _mm256_set1_epi32(static_cast<int>(value));
+
+        std::size_t i = 0;
+        for (; i + 8 <= count; i += 8) { _mm256_storeu_si256(reinterpret_cast<__m256i*>(bytes + i * 4), v); }
+        kernels::sse42.fill32(bytes + i * 4, value, count - i);
+    }
+
+    // Заполнение массива в обход кэша: начало до границы 32 байт обычной записью, затем по 32 байт потоковой записью
+    void streamFill32(void* dst, std::uint32_t value, std::size_t count) {
+        unsigned char* bytes = static_cast<unsigned char*>(dst);
+        std::size_t head = ((0 - reinterpret_cast<std::uintptr_t>(bytes)) & 31) / 4;
+        if (head >= count) {
+            fill32(bytes, value, count);
+            return;
+        }
+        fill32(bytes, value, head);
+
+        __m256i v = _mm256_set1_epi32(static_cast<int>(value));
+        std::size_t i = head;
+        for (; i + 8 <= count; i += 8) { _mm256_stream_si256(reinterpret_cast<__m256i*>(bytes + i * 4), v); }
+        // Потоковые записи упорядочиваются с последующими обычными
+        _mm_sfence();
+        kernels::sse42.fill32(bytes + i * 4, value, count - i);
+    }
+
+    // Отрезок строки буфера видимости: тест глубины и запись по маске для 8 пикселей.
+    // Параметр t накапливается по пикселям так же, как в скалярной версии, поэтому W совпадает побитово
+    float visibilitySpan(float* depth, std::uint32_t* ids, int count, float startW, float endW, float t, float tStep, std::uint32_t id) {
+        __m256 one = _mm256_set1_ps(1.f), sw = _mm256_set1_ps(startW), ew = _mm256_set1_ps(endW);
+        __m256 idv = _mm256_castsi256_ps(_mm256_set1_epi32(static_cast<int>(id)));
+
+        int j = 0;
+        for (; j + 8 <= count; j += 8) {
+            alignas(32) float tv[8];
+            for (int k = 0; k < 8; k++) {
+                tv[k] = t;
+                t += tStep;
+            }
+
+            __m256 tk = _mm256_load_ps(tv);
+            __m256 w = _mm256_add_ps(_mm256_mul_ps(_mm256_sub_ps(one, tk), sw), _mm256_mul_ps(tk, ew));
+            __m256 d = _mm256_loadu_ps(depth + j);
+            __m256 closer = _mm256_cmp_ps(w, d, _CMP_GT_OQ);
+            if (_mm256_movemask_ps(closer) == 0) continue;
+
+            _mm256_storeu_ps(depth + j, _mm256_blendv_ps(d, w, closer));
+            __m256 old = _mm256_loadu_ps(reinterpret_cast<const float*>(ids + j));
+            _mm256_storeu_ps(reinterpret_cast<float*>(ids + j), _mm256_blendv_ps(old, idv, closer));
+        }
+
+        // Остаток продолжает накопление t с того же значения
+        for (; j < count; j++) {
+            float w = (1.f - t) * startW + t * endW;
+            if (w > depth[j]) {
+                depth[j] = w;
+                ids[j] = id;
+            }
+            t += tStep;
+        }
+        return t;
+    }
+
+    // Выборка текстуры: 8 пикселей за итерацию со сбором по индексам
+    void sampleNearest(const void* texels, unsigned int width, unsigned int height, const float* u, const float* v, std::size_t count, std::uint32_t* out) {
+        const int* base = static_cast<const int*>(texels);
+        __m256 w = _mm256_set1_ps(static_cast<float>(width)), h = _mm256_set1_ps(static_cast<float>(height));
+        __m256 maxU = _mm256_set1_ps(static_cast<float>(width - 1)), maxV = _mm256_set1_ps(static_cast<float>(height - 1));
+        __m256i stride = _mm256_set1_epi32(static_cast<int>(width));
+
+        std::size_t i = 0;
+        for (; i + 8 <= count; i += 8) {
+            __m256i tu = _mm256_cvttps_epi32(_mm256_min_ps(_mm256_max_ps(_mm256_mul_ps(_mm256_loadu_ps(u + i), w), _mm256_setzero_ps()), maxU));
+            __m256i tv = _mm256_cvttps_epi32(_mm256_min_ps(_mm256_max_ps(_mm256_mul_ps(_mm256_loadu_ps(v + i), h), _mm256_setzero_ps()), maxV));
+            __m256i index = _mm256_add_epi32(_mm256_mullo_epi32(tv, stride), tu);
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), _mm256_i32gather_epi32(base, index, 4));
+        }
+        kernels::sse42.sampleNearest(texels, width, height, u + i, v + i, count - i, out + i);
+    }
+}
+
+const KernelTable kernels::avx2 = {transformPoints, classifyPlane, fill32, streamFill32, visibilitySpan, sampleNearest};
+#endif
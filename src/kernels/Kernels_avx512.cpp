@@ -0,0 +1,123 @@
+#include "kernels/Kernels.hpp"
+
+// Вариант ядер для AVX-512F (собирается с -mavx512f без FMA, вызывается только после проверки CPUID).
+// Кроме заголовка ядер здесь ничего не подключается, чтобы код с этими инструкциями не попал в общие функции
+#if ENGINE_KERNELS_X86
+#include <immintrin.h>
+
+namespace {
+    // Трансформация точек: по 16 вершин за итерацию
+    void transformPoints(const float* m, const float* x, const float* y, const float* z, std::size_t count,
+                         float* outX, float* outY, float* outZ, float* outW) {
+        __m512 m00 = _mm512_set1_ps(m[0]), m01 = _mm512_set1_ps(m[1]), m02 = _mm512_set1_ps(m[2]), m03 = _mm512_set1_ps(m[3]);
+        __m512 m10 = _mm512_set1_ps(m[4]), m11 = _mm512_set1_ps(m[5]), m12 = _mm512_set1_ps(m[6]), m13 = _mm512_set1_ps(m[7]);
+        __m512 m20 = _mm512_set1_ps(m[8]), m21 = _mm512_set1_ps(m[9]), m22 = _mm512_set1_ps(m[10]), m23 = _mm512_set1_ps(m[11]);
+        __m512 m30 = _mm512_set1_ps(m[12]), m31 = _mm512_set1_ps(m[13]), m32 = _mm512_set1_ps(m[14]), m33 = _mm512_set1_ps(m[15]);
+
+        std::size_t i = 0;
+        for (; i + 16 <= count; i += 16) {
+            __m512 vx = _mm512_loadu_ps(x + i), vy = _mm512_loadu_ps(y + i), vz = _mm512_loadu_ps(z + i);
+            _mm512_storeu_ps(outX + i, _mm512_add_ps(_mm512_add_ps(_mm512_add_ps(_mm512_mul_ps(vx, m00), _mm512_mul_ps(vy, m10)), _mm512_mul_ps(vz, m20)), m30));
+            _mm512_storeu_ps(outY + i, _mm512_add_ps(_mm512_add_ps(_mm512_add_ps(_mm512_mul_ps(vx, m01), _mm512_mul_ps(vy, m11)), _mm512_mul_ps(vz, m21)), m31));
+            _mm512_storeu_ps(outZ + i, _mm512_add_ps(_mm512_add_ps(_mm512_add_ps(_mm512_mul_ps(vx, m02), _mm512_mul_ps(vy, m12)), _mm512_mul_ps(vz, m22)), m32));
+            _mm512_storeu_ps(outW + i, _mm512_add_ps(_mm512_add_ps(_mm512_add_ps(_mm512_mul_ps(vx, m03), _mm512_mul_ps(vy, m13)), _mm512_mul_ps(vz, m23)), m33));
+        }
+        kernels::avx2.transformPoints(m, x + i, y + i, z + i, count - i, outX + i, outY + i, outZ + i, outW + i);
+    }
+
+    // Классификация точек относительно плоскости: по 16 точек за итерацию, маска сразу сужается до байтов
+    void classifyPlane(const float* plane, const float* x, const float* y, const float* z, std::size_t count, std::uint8_t* inside) {
+        __m512 nx = _mm512_set1_ps(plane[0]), ny = _mm512_set1_ps(plane[1]), nz = _mm512_set1_ps(plane[2]), d = _mm512_set1_ps(plane[3]);
+        __m512i ones = _mm512_set1_epi32(1);
+
+        std::size_t i = 0;
+        for (; i + 16 <= count; i += 16) {
+            __m512 dist = _mm512_sub_ps(_mm512_add_ps(_mm512_add_ps(_mm512_mul_ps(_mm512_loadu_ps(x + i), nx), _mm512_mul_ps(_mm512_loadu_ps(y + i), ny)), _mm512_mul_ps(_mm512_loadu_ps(z + i), nz)), d);
+            __mmask16 mask = _mm512_cmp_ps_mask(dist, _mm512_setzero_ps(), _CMP_GE_OQ);
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(inside + i), _mm512_cvtepi32_epi8(_mm512_maskz_mov_epi32(mask, ones)));
+        }
+        kernels::avx2.classifyPlane(plane, x + i, y + i, z + i, count - i, inside + i);
+    }
+
+    // Заполнение массива: по 64 байта за запись
+    void fill32(void* dst, std::uint32_t value, std::size_t count) {
+        unsigned char* bytes = static_cast<unsigned char*>(dst);
+        __m512i v = _mm512_set1_epi32(static_cast<int>(value));
+
+        std::size_t i = 0;
+        for (; i + 16 <= count; i += 16) { _mm512_storeu_si512(bytes + i * 4, v); }
+        kernels::avx2.fill32(bytes + i * 4, value, count - i);
+    }
+
+    // Заполнение массива в обход кэша: начало до границы 64 байт обычной записью, затем по 64 байт потоковой записью
+    void streamFill32(void* dst, std::uint32_t value, std::size_t count) {
+        unsigned char* bytes = static_cast<unsigned char*>(dst);
+        std::size_t head = ((0 - reinterpret_cast<std::uintptr_t>(bytes)) & 63) / 4;
+        if (head >= count) {
+            fill32(bytes, value, count);
+            return;
+        }
+        fill32(bytes, value, head);
+
+        __m512i v = _mm512_set1_epi32(static_cast<int>(value));
+        std::size_t i = head;
+        for (; i + 16 <= count; i += 16) { _mm512_stream_si512(reinterpret_cast<__m512i*>(bytes + i * 4), v); }
+        // Потоковые записи упорядочиваются с последующими обычными
+        _mm_sfence();
+        kernels::avx2.fill32(bytes + i * 4, value, count - i);
+    }
+
+    // Отрезок строки буфера видимости: тест глубины и запись по маске для 16 пикселей.
+    // Параметр t накапливается по пикселям так же, как в скалярной версии, поэтому W совпадает побитово
+    float visibilitySpan(float* depth, std::uint32_t* ids, int count, float startW, float endW, float t, float tStep, std::uint32_t id) {
+        __m512 one = _mm512_set1_ps(1.f), sw = _mm512_set1_ps(startW), ew = _mm512_set1_ps(endW);
+        __m512i idv = _mm512_set1_epi32(static_cast<int>(id));
+
+        int j = 0;
+        for (; j + 16 <= count; j += 16) {
+            alignas(64) float tv[16];
+            for (int k = 0; k < 16; k++) {
+                tv[k] = t;
+                t += tStep;
+            }
+
+            __m512 tk = _mm512_load_ps(tv);
+            __m512 w = _mm512_add_ps(_mm512_mul_ps(_mm512_sub_ps(one, tk), sw), _mm512_mul_ps(tk, ew));
+            __mmask16 closer = _mm512_cmp_ps_mask(w, _mm512_loadu_ps(depth + j), _CMP_GT_OQ);
+            if (closer == 0) continue;
+
+            _mm512_mask_storeu_ps(depth + j, closer, w);
+            _mm512_mask_storeu_epi32(ids + j, closer, idv);
+        }
+
+        // Остаток продолжает накопление t с того же значения
+        for (; j < count; j++) {
+            float w = (1.f - t) * startW + t * endW;
+            if (w > depth[j]) {
+                depth[j] = w;
+                ids[j] = id;
+            }
+            t += tStep;
+        }
+        return t;
+    }
+
+    // Выборка текстуры: 16 пикселей за итерацию со сбором по индексам
+    void sampleNearest(const void* texels, unsigned int width, unsigned int height, const float* u, const float* v, std::size_t count, std::uint32_t* out) {
+        __m512 w = _mm512_set1_ps(static_cast<float>(width)), h = _mm512_set1_ps(static_cast<float>(height));
+        __m512 maxU = _mm512_set1_ps(static_cast<float>(width - 1)), maxV = _mm512_set1_ps(static_cast<float>(height - 1));
+        __m512i stride = _mm512_set1_epi32(static_cast<int>(width));
+
+        std::size_t i = 0;
+        for (; i + 16 <= count; i += 16) {
+            __m512i tu = _mm512_cvttps_epi32(_mm512_min_ps(_mm512_max_ps(_mm512_mul_ps(_mm512_loadu_ps(u + i), w), _mm512_setzero_ps()), maxU));
+            __m512i tv = _mm512_cvttps_epi32(_mm512_min_ps(_mm512_max_ps(_mm512_mul_ps(_mm512_loadu_ps(v + i), h), _mm512_setzero_ps()), maxV));
+            __m512i index = _mm512_add_epi32(_mm512_mullo_epi32(tv, stride), tu);
+            _mm512_storeu_si512(out + i, _mm512_i32gather_epi32(index, texels, 4));
+        }
+        kernels::avx2.sampleNearest(texels, width, height, u + i, v + i, count - i, out + i);
+    }
+}
+
+const KernelTable kernels::avx512 = {transformPoints, classifyPlane, fill32, streamFill32, visibilitySpan, sampleNearest};
+#endif
@@ -0,0 +1,125 @@
+#include "kernels/Kernels.hpp"
+
+// Вариант ядер для SSE4.2 (собирается с -msse4.2, вызывается только после проверки CPUID).
+// Кроме заголовка ядер здесь ничего не подключается, чтобы код с этими инструкциями не попал в общие функции
+#if ENGINE_KERNELS_X86
+#include <nmmintrin.h>
+#include <cstring>
+
+namespace {
+    // Трансформация точек: по 4 вершины за итерацию
+    void transformPoints(const float* m, const float* x, const float* y, const float* z, std::size_t count,
+                         float* outX, float* outY, float* outZ, float* outW) {
+        __m128 m00 = _mm_set1_ps(m[0]), m01 = _mm_set1_ps(m[1]), m02 = _mm_set1_ps(m[2]), m03 = _mm_set1_ps(m[3]);
+        __m128 m10 = _mm_set1_ps(m[4]), m11 = _mm_set1_ps(m[5]), m12 = _mm_set1_ps(m[6]), m13 = _mm_set1_ps(m[7]);
+        __m128 m20 = _mm_set1_ps(m[8]), m21 = _mm_set1_ps(m[9]), m22 = _mm_set1_ps(m[10]), m23 = _mm_set1_ps(m[11]);
+        __m128 m30 = _mm_set1_ps(m[12]), m31 = _mm_set1_ps(m[13]), m32 = _mm_set1_ps(m[14]), m33 = _mm_set1_ps(m[15]);
+
+        std::size_t i = 0;
+        for (; i + 4 <= count; i += 4) {
+            __m128 vx = _mm_loadu_ps(x + i), vy = _mm_loadu_ps(y + i), vz = _mm_loadu_ps(z + i);
+            _mm_storeu_ps(outX + i, _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(vx, m00), _mm_mul_ps(vy, m10)), _mm_mul_ps(vz, m20)), m30));
+            _mm_storeu_ps(outY + i, _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(vx, m01), _mm_mul_ps(vy, m11)), _mm_mul_ps(vz, m21)), m31));
+            _mm_storeu_ps(outZ + i, _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(vx, m02), _mm_mul_ps(vy, m12)), _mm_mul_ps(vz, m22)), m32));
+            _mm_storeu_ps(outW + i, _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(vx, m03), _mm_mul_ps(vy, m13)), _mm_mul_ps(vz, m23)), m33));
+        }
+        kernels::scalar.transformPoints(m, x + i, y + i, z + i, count - i, outX + i, outY + i, outZ + i, outW + i);
+    }
+
+    // Классификация точек относительно плоскости: по 4 точки за итерацию
+    void classifyPlane(const float* plane, const float* x, const float* y, const float* z, std::size_t count, std::uint8_t* inside) {
+        __m128 nx = _mm_set1_ps(plane[0]), ny = _mm_set1_ps(plane[1]), nz = _mm_set1_ps(plane[2]), d = _mm_set1_ps(plane[3]);
+
+        std::size_t i = 0;
+        for (; i + 4 <= count; i += 4) {
+            __m128 dist = _mm_sub_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(_mm_loadu_ps(x + i), nx), _mm_mul_ps(_mm_loadu_ps(y + i), ny)), _mm_mul_ps(_mm_loadu_ps(z + i), nz)), d);
+            int mask = _mm_movemask_ps(_mm_cmpge_ps(dist, _mm_setzero_ps()));
+            for (int k = 0; k < 4; k++) { inside[i + k] = (mask >> k) & 1; }
+        }
+        kernels::scalar.classifyPlane(plane, x + i, y + i, z + i, count - i, inside + i);
+    }
+
+    // Заполнение массива: по 16 байт за запись
+    void fill32(void* dst, std::uint32_t value, std::size_t count) {
+        unsigned char* bytes = static_cast<unsigned char*>(dst);
+        __m128i v = _mm_set1_epi32(static_cast<int>(value));
+
+        std::size_t i = 0;
+        for (; i + 4 <= count; i += 4) { _mm_storeu_si128(reinterpret_cast<__m128i*>(bytes + i * 4), v); }
+        kernels::scalar.fill32(bytes + i * 4, value, count - i);
+    }
+
+    // Заполнение массива в обход кэша: начало до границы 16 байт обычной записью, затем по 16 байт потоковой записью
+    void streamFill32(void* dst, std::uint32_t value, std::size_t count) {
+        unsigned char* bytes = static_cast<unsigned char*>(dst);
+        std::size_t head = ((0 - reinterpret_cast<std::uintptr_t>(bytes)) & 15) / 4;
+        if (head >= count) {
+            fill32(bytes, value, count);
+            return;
+        }
+        fill32(bytes, value, head);
+
+        __m128i v = _mm_set1_epi32(static_cast<int>(value));
+        std::size_t i = head;
+        for (; i + 4 <= count; i += 4) { _mm_stream_si128(reinterpret_cast<__m128i*>(bytes + i * 4), v); }
+        // Потоковые записи упорядочиваются с последующими обычными
+        _mm_sfence();
+        kernels::scalar.fill32(bytes + i * 4, value, count - i);
+    }
+
+    // Отрезок строки буфера видимости: тест глубины и запись по маске для 4 пикселей.
+    // Параметр t накапливается по пикселям так же, как в скалярной версии, поэтому W совпадает побитово
+    float visibilitySpan(float* depth, std::uint32_t* ids, int count, float startW, float endW, float t, float tStep, std::uint32_t id) {
+        __m128 one = _mm_set1_ps(1.f), sw = _mm_set1_ps(startW), ew = _mm_set1_ps(endW);
+        __m128 idv = _mm_castsi128_ps(_mm_set1_epi32(static_cast<int>(id)));
+
+        int j = 0;
+        for (; j + 4 <= count; j += 4) {
+            float t0 = t, t1 = t0 + tStep, t2 = t1 + tStep, t3 = t2 + tStep;
+            t = t3 + tStep;
+
+            __m128 tv = _mm_setr_ps(t0, t1, t2, t3);
+            __m128 w = _mm_add_ps(_mm_mul_ps(_mm_sub_ps(one, tv), sw), _mm_mul_ps(tv, ew));
+            __m128 d = _mm_loadu_ps(depth + j);
+            __m128 closer = _mm_cmpgt_ps(w, d);
+            if (_mm_movemask_ps(closer) == 0) continue;
+
+            _mm_storeu_ps(depth + j, _mm_blendv_ps(d, w, closer));
+            __m128 old = _mm_loadu_ps(reinterpret_cast<const float*>(ids + j));
+            _mm_storeu_ps(reinterpret_cast<float*>(ids + j), _mm_blendv_ps(old, idv, closer));
+        }
+
+        // Остаток продолжает накопление t с того же значения
+        for (; j < count; j++) {
+            float w = (1.f - t) * startW + t * endW;
+            if (w > depth[j]) {
+                depth[j] = w;
+                ids[j] = id;
+            }
+            t += tStep;
+        }
+        return t;
+    }
+
+    // Выборка текстуры: координаты и индексы по 4 пикселя, сами выборки поштучно (в SSE нет сбора по индексам)
+    void sampleNearest(const void* texels, unsigned int width, unsigned int height, const float* u, const float* v, std::size_t count, std::uint32_t* out) {
+        const unsigned char* bytes = static_cast<const unsigned char*>(texels);
+        __m128 w = _mm_set1_ps(static_cast<float>(width)), h = _mm_set1_ps(static_cast<float>(height));
+        __m128 maxU = _mm_set1_ps(static_cast<float>(width - 1)), maxV = _mm_set1_ps(static_cast<float>(height - 1));
+        __m128i stride = _mm_set1_epi32(static_cast<int>(width));
+
+        std::size_t i = 0;
+        for (; i + 4 <= count; i += 4) {
+            __m128i tu = _mm_cvttps_epi32(_mm_min_ps(_mm_max_ps(_mm_mul_ps(_mm_loadu_ps(u + i), w), _mm_setzero_ps()), maxU));
+            __m128i tv = _mm_cvttps_epi32(_mm_min_ps(_mm_max_ps(_mm_mul_ps(_mm_loadu_ps(v + i), h), _mm_setzero_ps()), maxV));
+
+            alignas(16) std::uint32_t index[4];
+            _mm_store_si128(reinterpret_cast<__m128i*>(index), _mm_add_epi32(_mm_mullo_epi32(tv, stride), tu));
+            for (int k = 0; k < 4; k++) { std::memcpy(&out[i + k], bytes + static_cast<std::size_t>(index[k]) * 4, 4); }
+        }
+        kernels::scalar.sampleNearest(texels, width, height, u + i, v + i, count - i, out + i);
+    }
+}
+
+const KernelTable kernels::sse42 = {transformPoints, classifyPlane, fill32, streamFill32, visibilitySpan, sampleNearest};
+#endif
@@ -0,0 +1,38 @@
+#include "math/VertexTransform.hpp"
+
+#include <algorithm>
+
+#include "kernels/Kernels.hpp"
+
+// Трансформация потока точек
+void VertexTransform::points(const Mat4x4& mat, const PositionStreams& in, PositionStreams& out) {
+    out.resize(in.size());
+    points(mat, in.x.data(), in.y.data(), in.z.data(), in.size(), out.x.data(), out.y.data(), out.z.data(), out.w.data());
+}
+
+// Трансформация точек из массивов (вариант ядра выбран при запуске по набору инструкций процессора).
+// Каждая координата считается как ((x * m0 + y * m1) + z * m2) + m3 — в том же порядке, что и Vec3d * Mat4x4
+void VertexTransform::points(const Mat4x4& mat, const float* x, const float* y, const float* z, std::size_t count,
+                             float* outX, float* outY, float* outZ, float* outW) {
+    Kernels::get().transformPoints(&mat.m[0][0], x, y, z, count, outX, outY, outZ, outW);
+}
+
+// Трансформация квантованных точек
+void VertexTransform::points(const Mat4x4& mat, const std::uint16_t* x, const std::uint16_t* y, const std::uint16_t* z, std::size_t count,
+                             const std::uint32_t origin[3], const float min[3], const float step[3],
+                             float* outX, float* outY, float* outZ, float* outW) {
+    // Блок распакованных позиций умещается в L1 и сразу читается ядром трансформации
+    constexpr std::size_t blockSize = 256;
+    alignas(64) float bx[blockSize], by[blockSize], bz[blockSize];
+    auto transform = Kernels::get().transformPoints;
+
+    for (std::size_t first = 0; first < count; first += blockSize) {
+        std::size_t n = std::min(blockSize, count - first);
+        for (std::size_t i = 0; i < n; i++) {
+            bx[i] = min[0] + static_cast<float>(origin[0] + x[first + i]) * step[0];
+            by[i] = min[1] + static_cast<float>(origin[1] + y[first + i]) * step[1];
+            bz[i] = min[2] + static_cast<float>(origin[2] + z[first + i]) * step[2];
+        }
+        transform(&mat.m[0][0], bx, by, bz, n, outX + first, outY + first, outZ + first, outW + first);
+    }
+}
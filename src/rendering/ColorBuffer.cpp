@@ -0,0 +1,62 @@
+#include "rendering/ColorBuffer.hpp"
+
+#include <cstring>
+
+// Конструктор с заданием размеров
+ColorBuffer::ColorBuffer(int width, int height, bool tiled) { resize(width, height, tiled); }
+
+// Изменение размера и расположения буфера
+void ColorBuffer::resize(int width, int height, bool tiled) {
+    // Проверка корректности размеров
+    validateDimensions(width, height);
+
+    // Если размеры и расположение не изменились, выходим
+    BufferLayout layout(width, height, tiled);
+    if (layout == m_layout) return;
+
+    // Создание нового буфера (только если текущей памяти не хватает)
+    if (layout.size() > m_capacity) {
+        m_colorBuffer = std::make_unique<std::uint8_t[]>(layout.size() * 4);
+        m_capacity = layout.size();
+    }
+    // Обновление размеров и расположения
+    m_layout = layout;
+
+    // Очистка буфера
+    clear();
+}
+
+// Очистка буфера
+void ColorBuffer::clear() noexcept {
+    // Если буфер существует
+    if (m_colorBuffer) {
+        // Заполнение нулями (прозрачный чёрный, сквозь него виден цвет очистки окна)
+        std::fill(m_colorBuffer.get(), m_colorBuffer.get() + m_layout.size() * 4, 0);
+    }
+}
+
+// Копирование строк в кадр по строкам
+void ColorBuffer::resolve(std::uint8_t* out, int yBegin, int yEnd) const {
+    int width = m_layout.width();
+    for (int y = yBegin; y < yEnd; y++) {
+        std::uint8_t* row = out + static_cast<std::size_t>(y) * width * 4;
+        // Строка копируется участками, которые лежат в памяти подряд (по строке плитки или целиком)
+        for (int x = 0; x < width; ) {
+            int end = m_layout.runEnd(x, width);
+            std::memcpy(row + x * 4, m_colorBuffer.get() + static_cast<std::size_t>(m_layout.index(x, y)) * 4, (end - x) * 4);
+            x = end;
+        }
+    }
+}
+
+// Валидация размеров буфера
+void ColorBuffer::validateDimensions(int width, int height) const {
+    // Ошибка, если размеры некорректны
+    if (width <= 0 || height <= 0) { throw std::invalid_argument("Dimensions must be positive"); }
+}
+
+// Валидация индекса
+void ColorBuffer::validateCoordinates(int index) const {
+    // Ошибка, если индекс некорректен
+    if (index < 0 || static_cast<std::size_t>(index) >= m_layout.size()) { throw std::out_of_range("Invalid coordinates"); }
+}
@@ -1,40 +1,103 @@
 #include "rendering/DepthBuffer.hpp"
 
+#include <cstring>
+
+#include "kernels/Kernels.hpp"
+
 // Конструктор с заданием размеров
-DepthBuffer::DepthBuffer(int width, int height) { resize(width, height); }
+DepthBuffer::DepthBuffer(int width, int height, bool tiled) { resize(width, height, tiled); }
 
-// Изменение размера буфера
-void DepthBuffer::resize(int width, int height) {
+// Изменение размера и расположения буфера
+void DepthBuffer::resize(int width, int height, bool tiled) {
     // Проверка корректности размеров
     validateDimensions(width, height);
 
-    // Если размеры не изменились, выходим
-    if (width == m_width && height == m_height) return;
+    // Если размеры и расположение не изменились, выходим
+    BufferLayout layout(width, height, tiled);
+    if (layout == m_layout) return;
 
-    // Создание нового буфера
-    m_depthBuffer = std::make_unique<float[]>(width * height);
-    // Обновление ширины
-    m_width = width;
-    // Обновление высоты
-    m_height = height;
+    // Создание нового буфера (только если текущей памяти не хватает)
+    if (layout.size() > m_capacity) {
+        m_depthBuffer = std::make_unique<float[]>(layout.size());
+        m_capacity = layout.size();
+    }
+    // Обновление размеров и расположения
+    m_layout = layout;
+
+    // Номера кадров для новых полос
+    if (m_lazyClear) reserveStrips();
 
     // Очистка буфера
     clear(0.f);
 }
 
+// Выбор режима очистки
+void DepthBuffer::setClearMode(ClearMode mode) {
+    bool lazy = mode == ClearMode::Lazy;
+    if (lazy == m_lazyClear) return;
+
+    if (lazy) {
+        // Текущее содержимое буфера остаётся действительным до следующей очистки
+        reserveStrips();
+        std::fill(m_stripEpochs.get(), m_stripEpochs.get() + m_layout.stripCount(), m_epoch);
+    }
+    else {
+        // Полосы, которые ещё не заполнялись в этом кадре, заполняются сейчас
+        for (int strip = 0; strip < m_layout.stripCount(); strip++) {
+            if (m_stripEpochs[strip] != m_epoch) clearStrip(strip);
+        }
+    }
+    m_lazyClear = lazy;
+}
+
 // Очистка буфера
 void DepthBuffer::clear(float value) noexcept {
-    // Если буфер существует
-    if (m_depthBuffer) {
-        // Заполнение значением
-        std::fill(m_depthBuffer.get(), m_depthBuffer.get() + m_width * m_height, value);
+    // Если буфер не существует, выходим
+    if (!m_depthBuffer) return;
+
+    if (m_lazyClear) {
+        // Новый кадр: все полосы становятся устаревшими, а заполняются при первом обращении
+        m_clearValue = value;
+        // При переполнении номера кадра все полосы помечаются устаревшими явно (номер 0 не бывает текущим)
+        if (++m_epoch == 0) {
+            std::fill(m_stripEpochs.get(), m_stripEpochs.get() + m_stripCapacity, 0u);
+            m_epoch = 1;
+        }
+        return;
     }
+
+    // Заполнение значением в обход кэша (ядро под набор инструкций процессора):
+    // буфер больше кэша, и до растеризации его строки всё равно будут вытеснены
+    std::uint32_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    Kernels::get().streamFill32(m_depthBuffer.get(), bits, m_layout.size());
+}
+
+// Заполнение полосы значением очистки
+void DepthBuffer::clearStrip(int strip) noexcept {
+    // Обычная запись: полоса сразу используется растеризатором и должна остаться в кэше
+    std::uint32_t bits;
+    std::memcpy(&bits, &m_clearValue, sizeof(bits));
+    Kernels::get().fill32(m_depthBuffer.get() + strip * m_layout.stripSize(), bits, m_layout.stripSize());
+    m_stripEpochs[strip] = m_epoch;
+}
+
+// Выделение памяти под номера кадров полос
+void DepthBuffer::reserveStrips() {
+    if (m_layout.stripCount() <= m_stripCapacity) return;
+
+    // Новые полосы устаревшие (номер 0), пока их не заполнят
+    m_stripEpochs = std::make_unique<std::uint32_t[]>(m_layout.stripCount());
+    m_stripCapacity = m_layout.stripCount();
 }
 
 // Доступ к элементу буфера по индексу (неконстантная версия)
 float& DepthBuffer::operator()(int index) {
     // Проверка корректности индекса
     validateCoordinates(index);
+    // Полоса, ещё не заполненная в этом кадре, заполняется перед обращением
+    int strip = static_cast<int>(index / m_layout.stripSize());
+    if (m_lazyClear && m_stripEpochs[strip] != m_epoch) clearStrip(strip);
     return m_depthBuffer[index];
 }
 
@@ -42,6 +105,8 @@ float& DepthBuffer::operator()(int index) {
 const float& DepthBuffer::operator()(int index) const {
     // Проверка корректности индекса
     validateCoordinates(index);
+    // Полоса, ещё не заполненная в этом кадре, содержит значение очистки
+    if (m_lazyClear && m_stripEpochs[index / m_layout.stripSize()] != m_epoch) return m_clearValue;
     return m_depthBuffer[index];
 }
 
@@ -54,5 +119,11 @@ void DepthBuffer::validateDimensions(int width, int height) const {
 // Валидация индекса
 void DepthBuffer::validateCoordinates(int index) const {
     // Ошибка, если индекс некорректен
-    if (index > m_width * m_height || index < 0) { throw std::out_of_range("Invalid coordinates"); }
-}
\ No newline at end of file
+    if (index < 0 || static_cast<std::size_t>(index) >= m_layout.size()) { throw std::out_of_range("Invalid coordinates"); }
+}
+
+// Валидация координат пикселя
+void DepthBuffer::validatePixel(int x, int y) const {
+    // Ошибка, если пиксель за пределами буфера
+    if (x < 0 || x >= m_layout.width() || y < 0 || y >= m_layout.height()) { throw std::out_of_range("Invalid coordinates"); }
+}
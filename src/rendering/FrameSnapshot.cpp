@@ -0,0 +1,20 @@
+#include "rendering/FrameSnapshot.hpp"
+
+// Заполнение снимка
+void FrameSnapshot::capture(Camera& camera, const Scene& scene, Light& light, const RenderSettings& renderSettings) {
+    cameraPos = camera.getPos();
+    cameraDir = camera.getDir();
+    lightDir = light.getDir();
+    settings = renderSettings;
+
+    // Копируются только матрицы и оформление экземпляров, геометрия общая
+    items.clear();
+    for (const auto& instance : scene.getRenderList()) {
+        items.push_back({
+            instance, &instance->getMesh(), instance->getTexture(),
+            instance->getTint(), instance->isTinted(),
+            instance->getWorldMatrix(), instance->getWorldInverseMatrix(),
+            instance->isWorldMirrored(), instance->getWorldVersion()
+        });
+    }
+}
@@ -0,0 +1,359 @@
+#include "rendering/Rasterizer.hpp"
+
+#include <cmath>
+#include <cstring>
+
+#include "kernels/Kernels.hpp"
+
+namespace {
+    // Растеризация треугольника для заданного набора возможностей.
+    // Все проверки режима вычисляются на этапе компиляции, поэтому во внутреннем цикле нет ветвлений по настройкам
+    template<bool Textured, bool DepthTest, glbl::render::LightingMode Lighting>
+    void rasterizeTriangle(const Triangle& tri, DepthBuffer& depthBuffer, ColorBuffer& colorBuffer, const sf::Image* texture, int yMin, int yMax) {
+        // Извлечение координат вершин и текстурных координат
+        int   y1 = tri.p[0].y, y2 = tri.p[1].y, y3 = tri.p[2].y;
+        int   x1 = tri.p[0].x, x2 = tri.p[1].x, x3 = tri.p[2].x;
+        float u1 = tri.t[0].u, u2 = tri.t[1].u, u3 = tri.t[2].u;
+        float v1 = tri.t[0].v, v2 = tri.t[1].v, v3 = tri.t[2].v;
+        float w1 = tri.t[0].w, w2 = tri.t[1].w, w3 = tri.t[2].w;
+
+        // Треугольник не задевает полосу строк (проверяется до сортировки: каждая полоса перебирает все треугольники)
+        if (std::max({y1, y2, y3}) < yMin || std::min({y1, y2, y3}) > yMax) return;
+
+        // Сортировка вершин по Y (от меньшего к большему)
+        if (y2 < y1) { std::swap(y1, y2); std::swap(x1, x2); std::swap(u1, u2); std::swap(v1, v2); std::swap(w1, w2); }
+        if (y3 < y1) { std::swap(y1, y3); std::swap(x1, x3); std::swap(u1, u3); std::swap(v1, v3); std::swap(w1, w3); }
+        if (y3 < y2) { std::swap(y2, y3); std::swap(x2, x3); std::swap(u2, u3); std::swap(v2, v3); std::swap(w2, w3); }
+
+        // Расположение буферов кадра в памяти (у буферов глубины и цвета оно одно)
+        const BufferLayout& layout = colorBuffer.layout();
+
+        // Освещённость треугольника (без освещения — полная яркость)
+        float illumination = (Lighting == glbl::render::LightingMode::Flat) ? tri.illumination : 1.f;
+
+        // Пиксели и размеры текстуры
+        const std::uint8_t* texels = nullptr;
+        unsigned int texWidth = 0, texHeight = 0;
+        // Множители каналов текстуры (освещённость с учётом оттенка треугольника)
+        float shadeR = 0, shadeG = 0, shadeB = 0;
+        // Цвет треугольника (если текстура не используется)
+        sf::Color flatColor;
+
+        if constexpr (Textured) {
+            texels = texture->getPixelsPtr();
+            texWidth = texture->getSize().x;
+            texHeight = texture->getSize().y;
+
+            shadeR = illumination * tri.col.r / 255.f;
+            shadeG = illumination * tri.col.g / 255.f;
+            shadeB = illumination * tri.col.b / 255.f;
+        }
+        else {
+            Color triCol = Color(tri.col) * illumination;
+            flatColor = sf::Color(triCol.r, triCol.g, triCol.b);
+        }
+
+        // Пакет текстурированных пикселей, прошедших тест глубины: текстура выбирается ядром сразу для всего пакета
+        constexpr int batchSize = 64;
+        int batchPixels[batchSize];
+        float batchU[batchSize], batchV[batchSize];
+        std::uint32_t batchTexels[batchSize];
+        int pending = 0;
+        // Ядро выборки текстуры под набор инструкций процессора
+        auto sampleNearest = Kernels::get().sampleNearest;
+
+        // Лямбда-функция для выборки текстуры и записи накопленного пакета
+        auto flush = [&]() {
+            if (pending == 0) return;
+            sampleNearest(texels, texWidth, texHeight, batchU, batchV, pending, batchTexels);
+
+            for (int n = 0; n < pending; n++) {
+                std::uint8_t texCol[4];
+                std::memcpy(texCol, &batchTexels[n], sizeof(texCol));
+                // Запись пикселя с учётом освещения и оттенка
+                colorBuffer.setPixel(batchPixels[n], sf::Color(texCol[0] * shadeR, texCol[1] * shadeG, texCol[2] * shadeB));
+            }
+            pending = 0;
+        };
+
+        // Лямбда-функция для записи одного пикселя: тест глубины, обновление глубины и затенение
+        // (с текстурой — постановка в пакет). texW, texU и texV — интерполированные значения в пикселе (до перспективной коррекции)
+        auto plot = [&](int index, float* depth, float texW, float texU, float texV) {
+            // Проверка буфера глубины (если тест глубины включён)
+            if (DepthTest && !(texW > *depth)) return;
+
+            // Обновление буфера глубины
+            if constexpr (DepthTest) { *depth = texW; }
+
+            if constexpr (Textured) {
+                // Текстурные координаты с перспективной коррекцией (ядро переводит их в текселы)
+                float wInv = 1.0f / texW;
+                batchPixels[pending] = index;
+                batchU[pending] = texU * wInv;
+                batchV[pending] = texV * wInv;
+                if (++pending == batchSize) { flush(); }
+            }
+            else {
+                // Использование цвета треугольника, если текстура не используется
+                colorBuffer.setPixel(index, flatColor);
+            }
+        };
+
+        // Треугольник в одной клетке 2 x 2 пикселя (вершины в трёх её углах) закрашивает ровно один пиксель — левую
+        // из двух вершин общей строки. Он рисуется без вычисления шагов по сторонам, с теми же значениями, что и при проходе
+        // по строкам: у общей верхней строки значения вершин берутся как есть, у нижней — от первой вершины на один шаг
+        if (y3 - y1 == 1 && std::max({x1, x2, x3}) - std::min({x1, x2, x3}) == 1) {
+            int row = y1, xa = x1, xb = x2;
+            float wa = w1, ua = u1, va = v1, wb = w2, ub = u2, vb = v2;
+            if (y2 != y1) {
+                row = y3; xa = x2; xb = x3;
+                wa = w1 + (w2 - w1); ua = u1 + (u2 - u1); va = v1 + (v2 - v1);
+                wb = w1 + (w3 - w1); ub = u1 + (u3 - u1); vb = v1 + (v3 - v1);
+            }
+            // Совпадающие вершины не закрашивают ничего
+            if (xa == xb || row < yMin || row > yMax) return;
+            if (xb < xa) { xa = xb; wa = wb; ua = ub; va = vb; }
+
+            plot(layout.index(xa, row), DepthTest ? depthBuffer.at(xa, row) : nullptr, wa, ua, va);
+            if constexpr (Textured) { flush(); }
+            return;
+        }
+
+        // Лямбда-функция для растеризации одной половины треугольника (между строками yStart и yEnd).
+        // Первая сторона начинается в вершине (xa, ya), вторая — длинная сторона от первой до третьей вершины
+        auto rasterizeHalf = [&](int yStart, int yEnd, int xa, int ya, float ua, float va, float wa,
+                                 float daxStep, float duaStep, float dvaStep, float dwaStep,
+                                 float dbxStep, float dubStep, float dvbStep, float dwbStep) {
+            // Рисуются только строки полосы
+            for (int i = std::max(yStart, yMin); i <= std::min(yEnd, yMax); i++) {
+                // Вычисление начальной и конечной точек по X
+                int ax = xa + (float)(i - ya) * daxStep;
+                int bx = x1 + (float)(i - y1) * dbxStep;
+
+                // Интерполяция текстурных координат для начальной и конечной точек
+                float texSu = ua + (float)(i - ya) * duaStep;
+                float texSv = va + (float)(i - ya) * dvaStep;
+                float texSw = wa + (float)(i - ya) * dwaStep;
+
+                float texEu = u1 + (float)(i - y1) * dubStep;
+                float texEv = v1 + (float)(i - y1) * dvbStep;
+                float texEw = w1 + (float)(i - y1) * dwbStep;
+
+                // Если начальная точка правее конечной, меняем их местами
+                if (ax > bx) { std::swap(ax, bx); std::swap(texSu, texEu); std::swap(texSv, texEv); std::swap(texSw, texEw); }
+
+                // Шаг для интерполяции между начальной и конечной точками
+                float tstep = 1.f / ((float)(bx - ax));
+                float t = 0.f;
+
+                // Отрисовка пикселей между начальной и конечной точками участками, которые лежат в памяти подряд
+                // (при расположении плитками — по строке плитки, иначе вся строка сразу)
+                for (int runStart = ax; runStart < bx; ) {
+                    int runEnd = layout.runEnd(runStart, bx);
+                    // Глубина участка (без проверок на каждый пиксель) и индекс его начала в буфере цвета
+                    float* depthRun = DepthTest ? depthBuffer.at(runStart, i) : nullptr;
+                    int runIndex = layout.index(runStart, i);
+
+                    for (int j = runStart; j < runEnd; j++) {
+                        // Интерполяция W и текстурных координат (координаты нужны только с текстурой)
+                        float texW = (1.f - t) * texSw + t * texEw;
+                        float texU = Textured ? (1.f - t) * texSu + t * texEu : 0.f;
+                        float texV = Textured ? (1.f - t) * texSv + t * texEv : 0.f;
+
+                        plot(runIndex + (j - runStart), DepthTest ? depthRun + (j - runStart) : nullptr, texW, texU, texV);
+                        t += tstep;
+                    }
+
+                    runStart = runEnd;
+                }
+            }
+        };
+
+        // Шаги по X, U, V и W для длинной стороны (от первой до третьей вершины)
+        float dbxStep = 0, dubStep = 0, dvbStep = 0, dwbStep = 0;
+        if (y3 - y1) {
+            float dy = (float)(y3 - y1);
+            dbxStep = (x3 - x1) / dy; dubStep = (u3 - u1) / dy; dvbStep = (v3 - v1) / dy; dwbStep = (w3 - w1) / dy;
+        }
+
+        // Отрисовка верхней части треугольника (от y1 до y2)
+        if (y2 - y1) {
+            float dy = (float)(y2 - y1);
+            rasterizeHalf(y1, y2, x1, y1, u1, v1, w1, (x2 - x1) / dy, (u2 - u1) / dy, (v2 - v1) / dy, (w2 - w1) / dy, dbxStep, dubStep, dvbStep, dwbStep);
+        }
+        // Отрисовка нижней части треугольника (от y2 до y3)
+        if (y3 - y2) {
+            float dy = (float)(y3 - y2);
+            rasterizeHalf(y2, y3, x2, y2, u2, v2, w2, (x3 - x2) / dy, (u3 - u2) / dy, (v3 - v2) / dy, (w3 - w2) / dy, dbxStep, dubStep, dvbStep, dwbStep);
+        }
+
+        // Выборка текстуры для оставшихся пикселей
+        if constexpr (Textured) { flush(); }
+    }
+}
+
+// Выбор варианта растеризатора
+Rasterizer::TriangleFunc Rasterizer::select(bool textured, bool depthTest, glbl::render::LightingMode lighting) {
+    using glbl::render::LightingMode;
+
+    // Все комбинации возможностей инстанцируются заранее: [текстура][тест глубины][освещение]
+    static constexpr TriangleFunc variants[2][2][2] = {
+        {
+            { rasterizeTriangle<false, false, LightingMode::Unlit>, rasterizeTriangle<false, false, LightingMode::Flat> },
+            { rasterizeTriangle<false, true,  LightingMode::Unlit>, rasterizeTriangle<false, true,  LightingMode::Flat> }
+        },
+        {
+            { rasterizeTriangle<true,  false, LightingMode::Unlit>, rasterizeTriangle<true,  false, LightingMode::Flat> },
+            { rasterizeTriangle<true,  true,  LightingMode::Unlit>, rasterizeTriangle<true,  true,  LightingMode::Flat> }
+        }
+    };
+
+    return variants[textured][depthTest][lighting == LightingMode::Flat];
+}
+
+// Растеризация треугольника в буфер видимости
+void Rasterizer::visibilityTriangle(const Triangle& triangle, DepthBuffer& depthBuffer, VisibilityBuffer& visibilityBuffer, std::uint32_t id, int yMin, int yMax) {
+    // Извлечение координат вершин и W (для теста глубины текстурные координаты не нужны)
+    int   y1 = triangle.p[0].y, y2 = triangle.p[1].y, y3 = triangle.p[2].y;
+    int   x1 = triangle.p[0].x, x2 = triangle.p[1].x, x3 = triangle.p[2].x;
+    float w1 = triangle.t[0].w, w2 = triangle.t[1].w, w3 = triangle.t[2].w;
+
+    // Треугольник не задевает полосу строк (проверяется до сортировки)
+    if (std::max({y1, y2, y3}) < yMin || std::min({y1, y2, y3}) > yMax) return;
+
+    // Сортировка вершин по Y (от меньшего к большему)
+    if (y2 < y1) { std::swap(y1, y2); std::swap(x1, x2); std::swap(w1, w2); }
+    if (y3 < y1) { std::swap(y1, y3); std::swap(x1, x3); std::swap(w1, w3); }
+    if (y3 < y2) { std::swap(y2, y3); std::swap(x2, x3); std::swap(w2, w3); }
+
+    // Треугольник в одной клетке 2 x 2 пикселя закрашивает один пиксель (так же, как в растеризации с затенением)
+    if (y3 - y1 == 1 && std::max({x1, x2, x3}) - std::min({x1, x2, x3}) == 1) {
+        int row = y1, xa = x1, xb = x2;
+        float wa = w1, wb = w2;
+        if (y2 != y1) { row = y3; xa = x2; xb = x3; wa = w1 + (w2 - w1); wb = w1 + (w3 - w1); }
+        if (xa == xb || row < yMin || row > yMax) return;
+        if (xb < xa) { xa = xb; wa = wb; }
+
+        float* depth = depthBuffer.at(xa, row);
+        if (wa > *depth) {
+            *depth = wa;
+            *visibilityBuffer.at(xa, row) = id;
+        }
+        return;
+    }
+
+    // Ядро отрезка строки под набор инструкций процессора
+    auto visibilitySpan = Kernels::get().visibilitySpan;
+    // Расположение буферов кадра в памяти (у буферов глубины и видимости оно одно)
+    const BufferLayout& layout = depthBuffer.layout();
+
+    // Лямбда-функция для растеризации одной половины треугольника (между строками yStart и yEnd)
+    auto rasterizeHalf = [&](int yStart, int yEnd, int xa, int ya, float wa, float daxStep, float dwaStep, float dbxStep, float dwbStep) {
+        for (int i = std::max(yStart, yMin); i <= std::min(yEnd, yMax); i++) {
+            // Начальная и конечная точки строки по X и W
+            int ax = xa + (float)(i - ya) * daxStep;
+            int bx = x1 + (float)(i - y1) * dbxStep;
+            float sw = wa + (float)(i - ya) * dwaStep;
+            float ew = w1 + (float)(i - y1) * dwbStep;
+
+            // Если начальная точка правее конечной, меняем их местами
+            if (ax > bx) { std::swap(ax, bx); std::swap(sw, ew); }
+
+            if (ax >= bx) continue;
+
+            // Шаг для интерполяции между начальной и конечной точками
+            float tstep = 1.f / ((float)(bx - ax));
+
+            // Проверка буфера глубины и запись идентификатора ближайшего треугольника участками строки, которые лежат
+            // в памяти подряд. Параметр интерполяции продолжается между участками, как в одном отрезке
+            float t = 0.f;
+            for (int runStart = ax; runStart < bx; ) {
+                int runEnd = layout.runEnd(runStart, bx);
+                t = visibilitySpan(depthBuffer.at(runStart, i), visibilityBuffer.at(runStart, i), runEnd - runStart, sw, ew, t, tstep, id);
+                runStart = runEnd;
+            }
+        }
+    };
+
+    // Шаги по X и W для длинной стороны (от первой до третьей вершины)
+    float dbxStep = 0, dwbStep = 0;
+    if (y3 - y1) { dbxStep = (x3 - x1) / (float)(y3 - y1); dwbStep = (w3 - w1) / (float)(y3 - y1); }
+
+    // Верхняя часть треугольника (от y1 до y2)
+    if (y2 - y1) { rasterizeHalf(y1, y2, x1, y1, w1, (x2 - x1) / (float)(y2 - y1), (w2 - w1) / (float)(y2 - y1), dbxStep, dwbStep); }
+    // Нижняя часть треугольника (от y2 до y3)
+    if (y3 - y2) { rasterizeHalf(y2, y3, x2, y2, w2, (x3 - x2) / (float)(y3 - y2), (w3 - w2) / (float)(y3 - y2), dbxStep, dwbStep); }
+}
+
+// Отсечение отрезка прямоугольником экрана
+bool Rasterizer::clipLine(Vec3d& a, Vec3d& b, float width, float height) {
+    float dx = b.x - a.x, dy = b.y - a.y;
+    // Параметры входа в прямоугольник и выхода из него
+    float tEnter = 0.f, tExit = 1.f;
+
+    // Ограничения по четырём границам: p * t <= q
+    const float p[4] = {-dx, dx, -dy, dy};
+    const float q[4] = {a.x, width - 1 - a.x, a.y, height - 1 - a.y};
+    for (int i = 0; i < 4; i++) {
+        if (p[i] == 0.f) {
+            // Отрезок параллелен границе и лежит снаружи
+            if (q[i] < 0.f) return false;
+            continue;
+        }
+        float t = q[i] / p[i];
+        if (p[i] < 0.f) { tEnter = std::max(tEnter, t); }
+        else { tExit = std::min(tExit, t); }
+        if (tEnter > tExit) return false;
+    }
+
+    // Новые концы считаются по исходному отрезку
+    Vec3d start = a, end = b;
+    auto at = [&](float t) {
+        Vec3d point(start.x + t * dx, start.y + t * dy, start.z + t * (end.z - start.z));
+        point.w = start.w + t * (end.w - start.w);
+        return point;
+    };
+    if (tEnter > 0.f) { a = at(tEnter); }
+    if (tExit < 1.f) { b = at(tExit); }
+    return true;
+}
+
+// Растеризация отрезка
+void Rasterizer::line(const Vec3d& a, const Vec3d& b, const sf::Color& color, DepthBuffer& depthBuffer, ColorBuffer& colorBuffer, bool depthTest, int yMin, int yMax) {
+    // Число шагов по большей проекции: на каждом шаге ровно один пиксель
+    float dx = b.x - a.x, dy = b.y - a.y;
+    int steps = std::max(1, static_cast<int>(std::max(std::abs(dx), std::abs(dy))));
+    float sx = dx / steps, sy = dy / steps, sw = (b.w - a.w) / steps;
+
+    // Шаги, попадающие в полосу строк. Позиция шага считается от начала отрезка, а не накоплением,
+    // поэтому в любой полосе пиксели отрезка те же, что и при растеризации целиком
+    int kBegin = 0, kEnd = steps;
+    if (sy != 0.f) {
+        float k0 = (yMin - a.y) / sy, k1 = (yMax + 1 - a.y) / sy;
+        if (k0 > k1) { std::swap(k0, k1); }
+        // У почти горизонтального отрезка шаг по Y очень мал и границы выходят за диапазон int:
+        // они ограничиваются отрезком до приведения к целому
+        k0 = std::clamp(k0, -1.f, static_cast<float>(steps) + 1.f);
+        k1 = std::clamp(k1, -1.f, static_cast<float>(steps) + 1.f);
+        kBegin = std::max(kBegin, static_cast<int>(std::floor(k0)) - 1);
+        kEnd = std::min(kEnd, static_cast<int>(std::ceil(k1)) + 1);
+    }
+    else if (static_cast<int>(a.y) < yMin || static_cast<int>(a.y) > yMax) {
+        return;
+    }
+
+    // Запас теста глубины: отрезок лежит на гранях и не должен ими перекрываться
+    constexpr float bias = 1.f + glbl::render::edgeDepthBias;
+    const BufferLayout& layout = colorBuffer.layout();
+
+    for (int k = kBegin; k <= kEnd; k++) {
+        // Координаты неотрицательны после отсечения: приведение к целому совпадает с округлением вниз
+        int x = static_cast<int>(a.x + k * sx);
+        int y = static_cast<int>(a.y + k * sy);
+        if (y < yMin || y > yMax) continue;
+
+        // Проверка буфера глубины (отрезок за гранью не рисуется)
+        if (depthTest && (a.w + k * sw) * bias < *depthBuffer.at(x, y)) continue;
+        colorBuffer.setPixel(layout.index(x, y), color);
+    }
+}
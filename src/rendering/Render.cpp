@@ -1,162 +1,514 @@
 #include "rendering/Render.hpp"
 
+#include <cstring>
+
 // Конструктор
-Render::Render(Camera& camera) : m_camera(camera), m_depthBuffer(glbl::window::width, glbl::window::height) {}
+Render::Render(JobSystem& jobs) :
+    m_jobs(jobs),
+    // Матрица проекции зависит только от постоянных настроек и вычисляется один раз
+    matProj(Mat4x4::projection(glbl::render::fNear, glbl::render::fFar, glbl::render::fFov, (float)glbl::window::height / (float)glbl::window::width)),
+    m_depthBuffer(glbl::window::width, glbl::window::height),
+    m_resolutionScaler(glbl::render::frameTimeTarget, glbl::render::minResolutionScale),
+    m_renderWidth(glbl::window::width),
+    m_renderHeight(glbl::window::height),
+    m_resolutionScale(1.f)
+{
+    // Буфер глубины очищается по строкам при первом обращении в кадре (строка заполняется потоком своей полосы)
+    m_depthBuffer.setClearMode(glbl::render::lazyDepthClear ? DepthBuffer::ClearMode::Lazy : DepthBuffer::ClearMode::Fill);
 
-// Добавление модели в список для рендеринга
-void Render::addMesh(Mesh& mesh) {
-    m_renderMeshes.emplace_back(&mesh);
+    // Буферы цвета и видимости создаются при первом кадре, которому они нужны (режимы переключаются во время работы).
+    // Текстура кадра создаётся при первом выводе на экран: без окна (в режиме без вывода) она не нужна
 }
 
-// Обновление матриц вида и проекции
-void Render::update() {
+// Отрисовка кадра по снимку состояния
+void Render::render(sf::RenderTarget* target, const FrameSnapshot& snapshot) {
+    TRACE_SCOPE("Render::render");
+    // Таймер для измерения времени растеризации
+    sf::Clock rasterClock;
+
+    // Настройки кадра
+    m_settings = snapshot.settings;
+
+    // Профилирование стадий: счётчики открываются для потока рендера и рабочих потоков планировщика
+    if (m_settings.stageProfiling != m_profiler.isEnabled()) {
+        std::vector<int> threadIds = m_jobs.getWorkerThreadIds();
+        threadIds.push_back(0);
+        m_profiler.setEnabled(m_settings.stageProfiling, threadIds);
+    }
+    m_profiler.beginFrame();
+
     // Матрица вида (инвертированная матрица "наведения" камеры)
-    matView = Mat4x4::inverse(Mat4x4::pointAt(m_camera.getPos(), m_camera.getPos() + m_camera.getDir(), {0, 1, 0}));
-    // Матрица проекции (перспективная проекция)
-    matProj = Mat4x4::projection(glbl::render::fNear, glbl::render::fFar, glbl::render::fFov, (float)glbl::window::height / (float)glbl::window::width);
-}
+    matView = Mat4x4::inverse(Mat4x4::pointAt(snapshot.cameraPos, snapshot.cameraPos + snapshot.cameraDir, {0, 1, 0}));
 
-// Отрисовка сцены
-void Render::render(sf::RenderWindow& window, Light light) {
-    // Треугольники после проекции и отсечения
-    std::vector<Triangle> projectedTriangles, renderedTriangles;
-    // Текстурированные треугольники
-    std::vector<sf::VertexArray> texturedTriangles;
+    // Внутреннее разрешение кадра
+    float scale = m_settings.dynamicResolution ? m_resolutionScaler.getScale() : 1.f;
+    m_renderWidth = std::max(1, static_cast<int>(glbl::window::width * scale));
+    m_renderHeight = std::max(1, static_cast<int>(glbl::window::height * scale));
 
-    // Буферы для отрисовки треугольников и рёбер
-    sf::VertexArray drawingTriangles(sf::PrimitiveType::Triangles);
-    sf::VertexArray drawingEdges(sf::PrimitiveType::Lines);
-    // Цвет рёбер
-    sf::Color edgeColor(255, 128, 0);
+    // Подгонка буферов под внутреннее разрешение кадра и расположение в памяти (одно для всех буферов кадра)
+    bool tiled = m_settings.tiledBuffers;
+    m_depthBuffer.resize(m_renderWidth, m_renderHeight, tiled);
 
     // Очистка буфера глубины
     m_depthBuffer.clear(0.f);
 
-    // Обработка всех моделей
-    for (auto& mesh : m_renderMeshes) {
-        // Получение трансформированных треугольников
-        std::vector<Triangle> triangles = mesh->getTransformedTriangles();
-
-        // Обработка каждого треугольника
-        for (auto& triangle : triangles) {
-            // Проверка видимости задней грани (если включено)
-            if (glbl::render::backFaceVisible || triangle.getNormal().dot(triangle.p[0] - m_camera.getPos()) < 0) {
-                // Вычисление освещённости треугольника
-                triangle.illumination = std::max(0.3f, triangle.getNormal().dot(light.getDir()));
-
-                // Применение матрицы вида
-                Triangle projectedTriangle = triangle;
-                projectedTriangle *= matView;
-
-                // Отсечение треугольника относительно ближней плоскости
-                int clippedTriangles = 0;
-                Triangle clipped[2];
-                clippedTriangles = Triangle::clipAgainsPlane({0, 0, 0.1}, {0, 0, 1}, projectedTriangle, clipped[0], clipped[1]);
-                for (size_t i = 0; i < clippedTriangles; i++) {
-                    // Применение матрицы проекции
-                    projectedTriangle = clipped[i] * matProj;
-
-                    // Проецирование и масштабирование треугольника
-                    projectedTriangle.projectionDiv();
-                    projectedTriangle.scalingToDisplay();
-
-                    // Добавление треугольника в список
-                    projectedTriangles.emplace_back(projectedTriangle);
-                }
+    // Очистка буфера цвета
+    m_colorBuffer.resize(m_renderWidth, m_renderHeight, tiled);
+    m_colorBuffer.clear();
+
+    // Очистка буфера видимости
+    if (!m_settings.liteRender && m_settings.visibilityBuffer) {
+        m_visibilityBuffer.resize(m_renderWidth, m_renderHeight, tiled);
+        m_visibilityBuffer.clear();
+        m_visibleTriangles.clear();
+    }
+    m_profiler.endStage("clear");
+
+    // Экземпляры для рендеринга (экземпляры одной модели идут подряд)
+    const std::vector<FrameSnapshot::Item>& instances = snapshot.items;
+    if (m_instanceBatches.size() < instances.size()) { m_instanceBatches.resize(instances.size()); }
+
+    // Позиция камеры и направление света
+    Vec3d cameraPos = snapshot.cameraPos;
+    Vec3d lightDir = snapshot.lightDir;
+
+    // Обработка геометрии: экземпляры независимы, каждый обрабатывается отдельной задачей
+    m_jobs.parallelFor(static_cast<int>(instances.size()), 1, [&](int begin, int end) {
+        TRACE_SCOPE("geometry job");
+        for (int n = begin; n < end; n++) { processInstance(instances[n], cameraPos, lightDir, m_instanceBatches[n]); }
+    });
+    m_profiler.endStage("geometry");
+
+    // Высота полосы кадра: несколько полос на поток, чтобы потоки не простаивали на неравномерных полосах
+    int bands = static_cast<int>(m_jobs.getThreadCount()) * glbl::jobs::bandsPerThread;
+    int bandHeight = (m_renderHeight + bands - 1) / bands;
+    // Полоса кадра состоит из целых полос памяти буферов (строк плиток), чтобы потоки не делили их при отложенной очистке
+    int stripHeight = m_depthBuffer.layout().stripHeight();
+    bandHeight = (bandHeight + stripHeight - 1) / stripHeight * stripHeight;
+
+    // Растеризация в буфер видимости (затенение выполняется отдельным проходом после всех моделей)
+    if (!m_settings.liteRender && m_settings.visibilityBuffer) {
+        // Идентификаторы раздаются по порядку экземпляров, как при последовательной растеризации
+        for (size_t n = 0; n < instances.size(); n++) {
+            for (const auto& triangle : m_instanceBatches[n].rendered) {
+                // Удвоенная площадь треугольника на экране
+                float area = (triangle.p[1].x - triangle.p[0].x) * (triangle.p[2].y - triangle.p[0].y) - (triangle.p[2].x - triangle.p[0].x) * (triangle.p[1].y - triangle.p[0].y);
+                // Вырожденные треугольники не покрывают ни одного пикселя
+                if (area == 0.f) { continue; }
+
+                m_visibleTriangles.push_back({triangle, instances[n].texture, 1.f / area});
             }
         }
 
-        // Сортировка треугольников по глубине (если включён упрощённый рендеринг)
-        if (glbl::render::liteRender) {
-            std::sort(projectedTriangles.begin(), projectedTriangles.end(), [](const Triangle& t1, const Triangle& t2) {
-                return (t1.p[0].z + t1.p[1].z + t1.p[2].z)/3 > (t2.p[0].z + t2.p[1].z + t2.p[2].z)/3;
-            });
-        }
+        // Полосы кадра не пересекаются и растеризуются параллельно
+        m_jobs.parallelFor(m_renderHeight, bandHeight, [&](int yBegin, int yEnd) {
+            TRACE_SCOPE("visibility band");
+            for (size_t id = 0; id < m_visibleTriangles.size(); id++) {
+                Rasterizer::visibilityTriangle(m_visibleTriangles[id].triangle, m_depthBuffer, m_visibilityBuffer, static_cast<std::uint32_t>(id), yBegin, yEnd - 1);
+            }
+        });
+    }
+    // Рендер треугольников моделей (если упрощённый рендеринг отключён)
+    else if (!m_settings.liteRender) {
+        // Полосы кадра не пересекаются, а внутри полосы порядок треугольников тот же, что и при последовательной растеризации
+        m_jobs.parallelFor(m_renderHeight, bandHeight, [&](int yBegin, int yEnd) {
+            TRACE_SCOPE("raster band");
+            for (size_t n = 0; n < instances.size(); n++) {
+                // Вариант растеризатора выбирается один раз на весь экземпляр
+                sf::Image* texture = m_settings.textureVisible ? instances[n].texture : nullptr;
+                Rasterizer::TriangleFunc rasterize = Rasterizer::select(texture != nullptr, m_settings.depthTest, m_settings.lighting);
 
-        // Отсечение треугольников по границам экрана
-        for (const auto& triangle : projectedTriangles) {
-            Triangle clipped[2];
-            std::deque<Triangle> triangles;
-            triangles.emplace_back(triangle);
-            int newTriangles = 1;
+                for (const auto& triangle : m_instanceBatches[n].rendered) {
+                    rasterize(triangle, m_depthBuffer, m_colorBuffer, texture, yBegin, yEnd - 1);
+                }
+            }
+        });
+    }
+    // Упрощённый рендер: грани одним цветом и рёбра в тот же буфер цвета, теми же полосами кадра
+    else {
+        // Цвет рёбер
+        const sf::Color edgeColor(255, 128, 0);
+        Rasterizer::TriangleFunc fill = Rasterizer::select(false, m_settings.depthTest, m_settings.lighting);
 
-            // Отсечение по четырём границам экрана (верх, низ, лево, право)
-            for (size_t i = 0; i < 4; i++) {
-                int poligonsToAdd = 0;
+        m_jobs.parallelFor(m_renderHeight, bandHeight, [&](int yBegin, int yEnd) {
+            TRACE_SCOPE("lite band");
+            // Сначала все грани: рёбра проверяются по глубине уже нарисованных граней
+            if (m_settings.faceVisible) {
+                for (size_t n = 0; n < instances.size(); n++) {
+                    for (const auto& triangle : m_instanceBatches[n].rendered) { fill(triangle, m_depthBuffer, m_colorBuffer, nullptr, yBegin, yEnd - 1); }
+                }
+            }
 
-                while (newTriangles > 0) {
-                    Triangle tri = triangles.front();
-                    triangles.pop_front();
-                    newTriangles--;
-
-                    switch (i) {
-                    // Верхняя граница
-                    case 0: poligonsToAdd = Triangle::clipAgainsPlane({0, 0, 0}, {0, 1, 0}, tri, clipped[0], clipped[1]); break;
-                    // Нижняя граница
-                    case 1: poligonsToAdd = Triangle::clipAgainsPlane({0, (float)glbl::window::height - 1, 0}, {0, -1, 0}, tri, clipped[0], clipped[1]); break;
-                    // Левая граница
-                    case 2: poligonsToAdd = Triangle::clipAgainsPlane({0, 0, 0}, {1, 0, 0}, tri, clipped[0], clipped[1]); break;
-                    // Правая граница
-                    case 3: poligonsToAdd = Triangle::clipAgainsPlane({(float)glbl::window::width - 1, 0, 0}, {-1, 0, 0}, tri, clipped[0], clipped[1]); break;
-                    }
-
-                    for (int j = 0; j < poligonsToAdd; j++) {
-                        triangles.push_back(clipped[j]);
-                    }
+            for (size_t n = 0; n < instances.size(); n++) {
+                const std::vector<Vec3d>& edges = m_instanceBatches[n].edges;
+                for (size_t e = 0; e + 1 < edges.size(); e += 2) {
+                    Rasterizer::line(edges[e], edges[e + 1], edgeColor, m_depthBuffer, m_colorBuffer, m_settings.depthTest, yBegin, yEnd - 1);
                 }
+            }
+        });
+    }
+    m_profiler.endStage(m_settings.liteRender ? "lite raster" : "raster");
+
+    // Затенение видимых пикселей (в режиме буфера видимости), строки затеняются параллельно
+    if (!m_settings.liteRender && m_settings.visibilityBuffer) {
+        m_jobs.parallelFor(m_renderHeight, bandHeight, [&](int yBegin, int yEnd) {
+            TRACE_SCOPE("shade band");
+            shadeVisibilityBuffer(yBegin, yEnd);
+        });
+        m_profiler.endStage("shade");
+    }
+
+    // Время растеризации определяет разрешение следующего кадра
+    if (m_settings.dynamicResolution) { m_resolutionScaler.update(rasterClock.getElapsedTime().asSeconds() * 1000.f); }
+    // Масштаб, с которым нарисован этот кадр (при выключенном динамическом разрешении — полный)
+    m_resolutionScale.store(scale, std::memory_order_relaxed);
+
+    // Без окна кадр остаётся в буфере цвета
+    if (!target) {
+        m_profiler.endFrame();
+        return;
+    }
+
+    // Текстура кадра создаётся под полный размер окна, внутренний кадр занимает её часть
+    if (m_frameTexture.getSize().x == 0 && !m_frameTexture.resize({glbl::window::width, glbl::window::height})) {
+        // Ошибка, если текстуру кадра не удалось создать
+        throw std::runtime_error("Failed to create frame texture");
+    }
+
+    // Кадр, расположенный плитками, сначала собирается по строкам (полосы копируются параллельно)
+    const std::uint8_t* framePixels = m_colorBuffer.data();
+    if (m_colorBuffer.layout().isTiled()) {
+        m_framePixels.resize(static_cast<std::size_t>(m_renderWidth) * m_renderHeight * 4);
+        m_jobs.parallelFor(m_renderHeight, bandHeight, [&](int yBegin, int yEnd) { m_colorBuffer.resolve(m_framePixels.data(), yBegin, yEnd); });
+        framePixels = m_framePixels.data();
+    }
+
+    // Загрузка внутреннего кадра в текстуру и растягивание его на всё окно
+    m_frameTexture.update(framePixels, {(unsigned int)m_renderWidth, (unsigned int)m_renderHeight}, {0, 0});
+    // Билинейная фильтрация нужна только при растягивании внутреннего кадра
+    m_frameTexture.setSmooth(m_renderWidth != glbl::window::width);
+    sf::Sprite frame(m_frameTexture);
+    frame.setTextureRect(sf::IntRect({0, 0}, {m_renderWidth, m_renderHeight}));
+    frame.setScale({(float)glbl::window::width / m_renderWidth, (float)glbl::window::height / m_renderHeight});
+    target->draw(frame);
+    m_profiler.endStage("present");
+
+    m_profiler.endFrame();
+}
+
+// Обработка геометрии экземпляра: отсечение, трансформация и проекция его треугольников
+void Render::processInstance(const FrameSnapshot::Item& item, Vec3d cameraPos, const Vec3d& lightDir, InstanceBatch& batch) {
+    // Общая геометрия экземпляра
+    const Mesh& mesh = *item.mesh;
+
+    // Списки треугольников экземпляра переиспользуются между кадрами
+    batch.projected.clear();
+    batch.rendered.clear();
+
+    // Треугольники и нормали в пространстве модели (у упакованной модели — индексы и квантованные вершины)
+    const std::vector<Triangle>& triangles = mesh.getTriangles();
+    const std::vector<std::uint32_t>& indices = mesh.getIndices();
+    const PackedMesh* packed = mesh.getPacked();
+    size_t triangleCount = mesh.getTriangleCount();
+
+    // Память под списки выделяется заранее с запасом на отсечение, а не по мере появления видимых треугольников
+    if (batch.projected.capacity() < triangleCount) {
+        batch.projected.reserve(triangleCount * 2);
+        batch.rendered.reserve(triangleCount * 2);
+        batch.clip.reserve(triangleCount * 6);
+    }
+    const std::vector<Vec3d>& normals = mesh.getNormals();
+    // Освещённость берётся из кэша экземпляра
+    updateIllumination(item, lightDir, batch);
+    const std::vector<float>& illumination = batch.illumination;
+
+    // Позиция камеры в пространстве модели (один раз на экземпляр за кадр)
+    Vec3d cameraObjectPos = cameraPos * item.worldInverse;
+    // У отражённого экземпляра лицевая сторона треугольников противоположна нормали
+    float facing = item.mirrored ? -1.f : 1.f;
+    // Объединённая матрица модели и вида
+    Mat4x4 matModelView = item.world * matView;
+    // Оттенок экземпляра
+    bool tinted = item.tinted;
+    const Color& tint = item.tint;
+
+    // Применение матриц модели и вида ко всем вершинам одним пакетом: потоковая трансформация
+    // всех вершин дешевле, чем поштучная трансформация только видимых.
+    // Упакованная модель распаковывается внутри трансформации небольшими блоками
+    const PositionStreams& model = mesh.getPositions();
+    if (packed) { packed->transformPositions(matModelView, batch.view); }
+    else { VertexTransform::points(matModelView, model, batch.view); }
+    const PositionStreams& view = batch.view;
+    batch.clip.clear();
+
+    // Ближняя плоскость и классификация всех вершин относительно неё одним пакетом (так же, как в Triangle::clipAgainsPlane)
+    const Vec3d nearPoint(0, 0, 0.1f), nearNormal = Vec3d(0, 0, 1).normalize();
+    const float nearPlane[4] = {nearNormal.x, nearNormal.y, nearNormal.z, nearNormal.dot(nearPoint)};
+    batch.nearInside.resize(view.size());
+    Kernels::get().classifyPlane(nearPlane, view.x.data(), view.y.data(), view.z.data(), view.size(), batch.nearInside.data());
+    const std::uint8_t* nearInside = batch.nearInside.data();
+
+    // Видимость граней нужна только для рёбер каркасного режима
+    bool wireframe = m_settings.liteRender && m_settings.edgeVisible;
+    if (wireframe) { batch.faceVisible.assign(triangleCount, 0); }
+
+    // Обработка каждого треугольника
+    for (size_t k = 0; k < triangleCount; k++) {
+        // Вершины треугольника в потоках позиций
+        std::uint32_t corners[3];
+        if (packed) { packed->getCorners(k, corners); }
+        else { for (size_t j = 0; j < 3; j++) { corners[j] = indices[k * 3 + j]; } }
 
-                newTriangles = triangles.size();
+        // Проверка видимости задней грани в пространстве модели
+        Vec3d p0 = packed ? packed->getPosition(k, corners[0]) : Vec3d(model.x[corners[0]], model.y[corners[0]], model.z[corners[0]]);
+        if (m_settings.backFaceVisible || facing * normals[k].dot(p0 - cameraObjectPos) < 0) {
+            // Треугольник целиком за ближней плоскостью отсекается до копирования
+            int insideCount = nearInside[corners[0]] + nearInside[corners[1]] + nearInside[corners[2]];
+            if (insideCount == 0) continue;
+            if (wireframe) { batch.faceVisible[k] = 1; }
+
+            // Треугольник с вершинами в пространстве вида
+            Triangle projectedTriangle = packed ? Triangle() : triangles[k];
+            for (size_t j = 0; j < 3; j++) {
+                std::uint32_t v = corners[j];
+                projectedTriangle.p[j] = Vec3d(view.x[v], view.y[v], view.z[v]);
+                projectedTriangle.p[j].w = view.w[v];
+                if (packed) { projectedTriangle.t[j] = packed->getTextureCoords(v); }
             }
+            // Освещённость треугольника
+            projectedTriangle.illumination = illumination[k];
+            // Применение оттенка экземпляра
+            if (tinted) { projectedTriangle.col = projectedTriangle.col.modulate(tint); }
 
-            // Добавление отсечённых треугольников в список
-            for (const auto& tri : triangles) { renderedTriangles.emplace_back(tri); }
-        }
+            // Треугольник целиком перед ближней плоскостью не изменяется при отсечении
+            if (insideCount == 3) {
+                for (const auto& vertex : projectedTriangle.p) { batch.clip.push(vertex.x, vertex.y, vertex.z); }
+                batch.projected.emplace_back(projectedTriangle);
+                continue;
+            }
 
-        // Рендер текстурированных треугольников (если упрощённый рендеринг отключён)
-        if (!glbl::render::liteRender) {
-            for (auto& triangle : renderedTriangles) {
-                texturedTriangles.emplace_back(triangle.texturedTriangle(m_depthBuffer, mesh->getTexture()));
+            // Отсечение треугольника относительно ближней плоскости
+            int clippedTriangles = 0;
+            Triangle clipped[2];
+            clippedTriangles = Triangle::clipAgainsPlane(nearPoint, nearNormal, projectedTriangle, clipped[0], clipped[1]);
+            for (size_t i = 0; i < clippedTriangles; i++) {
+                // Вершины собираются в поток для пакетной проекции
+                for (const auto& vertex : clipped[i].p) { batch.clip.push(vertex.x, vertex.y, vertex.z); }
+                // Добавление треугольника в список
+                batch.projected.emplace_back(clipped[i]);
             }
         }
     }
 
-    // Отрисовка сцены
-    if (glbl::render::liteRender) {
-        // Упрощённый рендеринг (треугольники и рёбра)
-        for (const auto& triangle : renderedTriangles) {
-            sf::Color faceColor(triangle.col.r * triangle.illumination, triangle.col.g * triangle.illumination, triangle.col.b * triangle.illumination);
+    // Применение матрицы проекции ко всем вершинам после отсечения одним пакетом (на месте)
+    PositionStreams& clip = batch.clip;
+    VertexTransform::points(matProj, clip.x.data(), clip.y.data(), clip.z.data(), clip.size(), clip.x.data(), clip.y.data(), clip.z.data(), clip.w.data());
+    for (size_t k = 0; k < batch.projected.size(); k++) {
+        Triangle& triangle = batch.projected[k];
+        for (size_t j = 0; j < 3; j++) {
+            size_t v = k * 3 + j;
+            triangle.p[j] = Vec3d(clip.x[v], clip.y[v], clip.z[v]);
+            triangle.p[j].w = clip.w[v];
+        }
+
+        // Проецирование и масштабирование треугольника
+        triangle.projectionDiv();
+        triangle.scalingToDisplay(m_renderWidth, m_renderHeight);
+    }
 
-            // Отрисовка треугольников (если включено)
-            if (glbl::render::faceVisible) {
-                drawingTriangles.append(sf::Vertex{sf::Vector2f(triangle.p[0].x, triangle.p[0].y), faceColor});
-                drawingTriangles.append(sf::Vertex{sf::Vector2f(triangle.p[1].x, triangle.p[1].y), faceColor});
-                drawingTriangles.append(sf::Vertex{sf::Vector2f(triangle.p[2].x, triangle.p[2].y), faceColor});
+    // Рёбра каркасного режима: каждое ребро модели один раз, если видна хотя бы одна из соседних граней
+    batch.edges.clear();
+    if (wireframe) {
+        const std::vector<MeshEdge>& edges = mesh.getEdges();
+        if (batch.edges.capacity() < edges.size() * 2) { batch.edges.reserve(edges.size() * 2); }
+
+        for (const MeshEdge& edge : edges) {
+            bool visible = batch.faceVisible[edge.triangles[0]] || (edge.triangles[1] != MeshEdge::noTriangle && batch.faceVisible[edge.triangles[1]]);
+            std::uint32_t a = edge.vertices[0], b = edge.vertices[1];
+            if (!visible || (!nearInside[a] && !nearInside[b])) continue;
+
+            // Ребро, пересекающее ближнюю плоскость, укорачивается до неё
+            Vec3d ends[2] = {Vec3d(view.x[a], view.y[a], view.z[a]), Vec3d(view.x[b], view.y[b], view.z[b])};
+            float t;
+            if (!nearInside[a]) { ends[0].intersectPlane(nearPoint, nearNormal, ends[1], Vec3d(view.x[a], view.y[a], view.z[a]), t); }
+            if (!nearInside[b]) { ends[1].intersectPlane(nearPoint, nearNormal, ends[0], Vec3d(view.x[b], view.y[b], view.z[b]), t); }
+
+            // Проецирование и масштабирование теми же функциями, что и у вершин треугольников
+            for (Vec3d& end : ends) {
+                end.w = 1.f;
+                end = end * matProj;
+                float w = end.w;
+                end.projectionDiv();
+                end.scalingToDisplay(m_renderWidth, m_renderHeight);
+                end.w = 1.f / w;
             }
 
-            // Отрисовка рёбер (если включено)
-            if (glbl::render::edgeVisible) {
-                drawingEdges.append(sf::Vertex{sf::Vector2f(triangle.p[0].x, triangle.p[0].y), edgeColor});
-                drawingEdges.append(sf::Vertex{sf::Vector2f(triangle.p[1].x, triangle.p[1].y), edgeColor});
-                drawingEdges.append(sf::Vertex{sf::Vector2f(triangle.p[1].x, triangle.p[1].y), edgeColor});
-                drawingEdges.append(sf::Vertex{sf::Vector2f(triangle.p[2].x, triangle.p[2].y), edgeColor});
-                drawingEdges.append(sf::Vertex{sf::Vector2f(triangle.p[2].x, triangle.p[2].y), edgeColor});
-                drawingEdges.append(sf::Vertex{sf::Vector2f(triangle.p[0].x, triangle.p[0].y), edgeColor});
+            // Рёбра отсекаются по границам экрана один раз, а не в каждой полосе кадра
+            if (!Rasterizer::clipLine(ends[0], ends[1], (float)m_renderWidth, (float)m_renderHeight)) continue;
+            batch.edges.push_back(ends[0]);
+            batch.edges.push_back(ends[1]);
+        }
+    }
+
+    // Сортировка треугольников по глубине (в упрощённом рендере без теста глубины грани рисуются от дальних к ближним)
+    if (m_settings.liteRender && !m_settings.depthTest) {
+        std::sort(batch.projected.begin(), batch.projected.end(), [](const Triangle& t1, const Triangle& t2) {
+            return (t1.p[0].z + t1.p[1].z + t1.p[2].z)/3 > (t2.p[0].z + t2.p[1].z + t2.p[2].z)/3;
+        });
+    }
+
+    // Каждая граница экрана может удвоить число треугольников: после четырёх границ их не больше 16.
+    // Два массива на стеке сменяют друг друга вместо очереди в динамической памяти
+    Triangle buffers[2][16];
+
+    // Отсечение треугольников по границам экрана
+    for (const auto& triangle : batch.projected) {
+        Triangle clipped[2];
+        Triangle* triangles = buffers[0];
+        Triangle* next = buffers[1];
+        triangles[0] = triangle;
+        int count = 1;
+
+        // Отсечение по четырём границам экрана (верх, низ, лево, право)
+        for (size_t i = 0; i < 4; i++) {
+            int nextCount = 0;
+
+            for (int k = 0; k < count; k++) {
+                const Triangle& tri = triangles[k];
+                int poligonsToAdd = 0;
+
+                switch (i) {
+                // Верхняя граница
+                case 0: poligonsToAdd = Triangle::clipAgainsPlane({0, 0, 0}, {0, 1, 0}, tri, clipped[0], clipped[1]); break;
+                // Нижняя граница
+                case 1: poligonsToAdd = Triangle::clipAgainsPlane({0, (float)m_renderHeight - 1, 0}, {0, -1, 0}, tri, clipped[0], clipped[1]); break;
+                // Левая граница
+                case 2: poligonsToAdd = Triangle::clipAgainsPlane({0, 0, 0}, {1, 0, 0}, tri, clipped[0], clipped[1]); break;
+                // Правая граница
+                case 3: poligonsToAdd = Triangle::clipAgainsPlane({(float)m_renderWidth - 1, 0, 0}, {-1, 0, 0}, tri, clipped[0], clipped[1]); break;
+                }
+
+                for (int j = 0; j < poligonsToAdd; j++) {
+                    next[nextCount++] = clipped[j];
+                }
             }
+
+            std::swap(triangles, next);
+            count = nextCount;
+        }
+
+        // Добавление отсечённых треугольников в список. Треугольники, не закрашивающие ни одного пикселя (вырожденные
+        // и меньше пикселя на дальней местности), отбрасываются здесь, а не в каждой полосе кадра
+        for (int k = 0; k < count; k++) {
+            if (Rasterizer::coversPixels(triangles[k])) { batch.rendered.emplace_back(triangles[k]); }
         }
+    }
+}
+
+// Пересчёт освещённости треугольников экземпляра
+void Render::updateIllumination(const FrameSnapshot::Item& item, const Vec3d& lightDir, InstanceBatch& batch) {
+    // Пересчёт только при смене экземпляра, изменении его мировой матрицы или направления света
+    bool lightChanged = lightDir.x != batch.lightDir.x || lightDir.y != batch.lightDir.y || lightDir.z != batch.lightDir.z;
+    if (batch.owner != item.owner || batch.version != item.version || lightChanged) {
+        const std::vector<Vec3d>& normals = item.mesh->getNormals();
+        // Знак, приводящий нормали к стороне, на которую смотрят мировые треугольники
+        float facing = item.mirrored ? -1.f : 1.f;
 
-        // Отрисовка треугольников и рёбер на экран
-        if (glbl::render::faceVisible && drawingTriangles.getVertexCount() > 0) {
-            window.draw(drawingTriangles);
+        // Матрица нормалей: транспонированная обратная мировая (без перемещения), верна и для неравномерного масштаба родителей
+        const Mat4x4& inv = item.worldInverse;
+        Mat4x4 matNormal = Mat4x4::scale(1, 1, 1);
+        for (int r = 0; r < 3; r++) {
+            for (int c = 0; c < 3; c++) { matNormal.m[r][c] = inv.m[c][r]; }
         }
 
-        if (glbl::render::edgeVisible && drawingEdges.getVertexCount() > 0) {
-            window.draw(drawingEdges);
+        batch.illumination.resize(normals.size());
+        for (size_t i = 0; i < normals.size(); i++) {
+            // Мировая нормаль (без перемещения) нужна только здесь и не хранится
+            Vec3d normal = normals[i];
+            normal.w = 0;
+            Vec3d worldNormal = (normal * matNormal).normalize() * facing;
+
+            batch.illumination[i] = std::max(0.3f, worldNormal.dot(lightDir));
         }
+
+        batch.owner = item.owner;
+        batch.version = item.version;
+        batch.lightDir = lightDir;
     }
-    else {
-        // Отрисовка текстурированных треугольников
-        for (const auto& pixels : texturedTriangles) {
-            window.draw(pixels);
+}
+
+// Проход затенения буфера видимости
+void Render::shadeVisibilityBuffer(int yBegin, int yEnd) {
+    // Текстурированные пиксели копятся в пакет одной текстуры, и выборка выполняется ядром сразу для всего пакета
+    constexpr int batchSize = 64;
+    int pixels[batchSize];
+    const VisibleTriangle* owners[batchSize];
+    float texU[batchSize], texV[batchSize];
+    std::uint32_t texels[batchSize];
+    int pending = 0;
+    const sf::Image* batchTexture = nullptr;
+
+    // Освещённость треугольника (без освещения — полная яркость)
+    bool flat = m_settings.lighting == glbl::render::LightingMode::Flat;
+
+    // Выборка и запись накопленного пакета
+    auto flush = [&]() {
+        if (pending == 0) return;
+        Kernels::get().sampleNearest(batchTexture->getPixelsPtr(), batchTexture->getSize().x, batchTexture->getSize().y, texU, texV, pending, texels);
+
+        for (int n = 0; n < pending; n++) {
+            const Triangle& tri = owners[n]->triangle;
+            float illumination = flat ? tri.illumination : 1.f;
+
+            // Цвет текстуры с учётом освещения и оттенка треугольника
+            std::uint8_t texCol[4];
+            std::memcpy(texCol, &texels[n], sizeof(texCol));
+            m_colorBuffer.setPixel(pixels[n], sf::Color(texCol[0] * illumination * tri.col.r / 255.f, texCol[1] * illumination * tri.col.g / 255.f, texCol[2] * illumination * tri.col.b / 255.f));
+        }
+        pending = 0;
+    };
+
+    // Расположение буферов кадра в памяти (у буферов видимости и цвета оно одно)
+    const BufferLayout& layout = m_visibilityBuffer.layout();
+
+    for (int i = yBegin; i < yEnd; i++) {
+        for (int j = 0; j < m_visibilityBuffer.width(); j++) {
+            int index = layout.index(j, i);
+
+            // Пропуск пикселей, в которые не попал ни один треугольник
+            std::uint32_t id = m_visibilityBuffer(index);
+            if (id == VisibilityBuffer::emptyId) { continue; }
+
+            const VisibleTriangle& visible = m_visibleTriangles[id];
+            const Triangle& tri = visible.triangle;
+
+            if (visible.texture && m_settings.textureVisible) {
+                // Восстановление барицентрических координат пикселя в экранном пространстве
+                float b1 = ((j - tri.p[0].x) * (tri.p[2].y - tri.p[0].y) - (tri.p[2].x - tri.p[0].x) * (i - tri.p[0].y)) * visible.invArea;
+                float b2 = ((tri.p[1].x - tri.p[0].x) * (i - tri.p[0].y) - (j - tri.p[0].x) * (tri.p[1].y - tri.p[0].y)) * visible.invArea;
+                float b0 = 1.f - b1 - b2;
+
+                // Пакет выбирается целиком при смене текстуры или заполнении
+                if (visible.texture != batchTexture || pending == batchSize) {
+                    flush();
+                    batchTexture = visible.texture;
+                }
+
+                // Интерполяция текстурных координат и W с перспективной коррекцией
+                float texW = b0 * tri.t[0].w + b1 * tri.t[1].w + b2 * tri.t[2].w;
+                float wInv = 1.f / texW;
+                pixels[pending] = index;
+                owners[pending] = &visible;
+                texU[pending] = (b0 * tri.t[0].u + b1 * tri.t[1].u + b2 * tri.t[2].u) * wInv;
+                texV[pending] = (b0 * tri.t[0].v + b1 * tri.t[1].v + b2 * tri.t[2].v) * wInv;
+                pending++;
+            }
+            else {
+                // Использование цвета треугольника, если текстура не используется
+                Color triCol = Color(tri.col) * (flat ? tri.illumination : 1.f);
+                m_colorBuffer.setPixel(index, sf::Color(triCol.r, triCol.g, triCol.b));
+            }
         }
     }
-}
\ No newline at end of file
+    flush();
+}
@@ -0,0 +1,25 @@
+#include "rendering/ResolutionScaler.hpp"
+
+// Конструктор
+ResolutionScaler::ResolutionScaler(float targetTime, float minScale) : m_targetTime(targetTime), m_minScale(minScale) {}
+
+// Подбор масштаба по измеренному времени растеризации
+void ResolutionScaler::update(float rasterTime) {
+    // Экспоненциальное сглаживание, чтобы единичный медленный кадр не дёргал разрешение
+    m_averageTime = (m_averageTime == 0.f) ? rasterTime : m_averageTime * 0.8f + rasterTime * 0.2f;
+
+    // Стоимость растеризации пропорциональна числу пикселей, то есть квадрату масштаба
+    float desiredScale = m_scale * std::sqrt(m_targetTime / std::max(m_averageTime, 0.001f));
+
+    if (m_averageTime > m_targetTime) {
+        // Превышение бюджета: быстро уменьшаем разрешение (не более чем на 10% за кадр)
+        m_scale = std::max(desiredScale, m_scale * 0.9f);
+    }
+    else if (m_averageTime < m_targetTime * 0.85f) {
+        // Запас по времени: плавно повышаем разрешение (не более чем на 2% за кадр)
+        m_scale = std::min(desiredScale, m_scale * 1.02f);
+    }
+
+    // Ограничение масштаба допустимым диапазоном
+    m_scale = std::clamp(m_scale, m_minScale, 1.f);
+}
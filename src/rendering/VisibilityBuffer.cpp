@@ -0,0 +1,68 @@
+#include "rendering/VisibilityBuffer.hpp"
+
+#include "kernels/Kernels.hpp"
+
+// Конструктор с заданием размеров
+VisibilityBuffer::VisibilityBuffer(int width, int height, bool tiled) { resize(width, height, tiled); }
+
+// Изменение размера и расположения буфера
+void VisibilityBuffer::resize(int width, int height, bool tiled) {
+    // Проверка корректности размеров
+    validateDimensions(width, height);
+
+    // Если размеры и расположение не изменились, выходим
+    BufferLayout layout(width, height, tiled);
+    if (layout == m_layout) return;
+
+    // Создание нового буфера (только если текущей памяти не хватает)
+    if (layout.size() > m_capacity) {
+        m_visibilityBuffer = std::make_unique<std::uint32_t[]>(layout.size());
+        m_capacity = layout.size();
+    }
+    // Обновление размеров и расположения
+    m_layout = layout;
+
+    // Очистка буфера
+    clear();
+}
+
+// Очистка буфера
+void VisibilityBuffer::clear() noexcept {
+    // Если буфер существует
+    if (m_visibilityBuffer) {
+        // Заполнение идентификатором пустого пикселя (ядро под набор инструкций процессора)
+        Kernels::get().fill32(m_visibilityBuffer.get(), emptyId, m_layout.size());
+    }
+}
+
+// Доступ к элементу буфера по индексу (неконстантная версия)
+std::uint32_t& VisibilityBuffer::operator()(int index) {
+    // Проверка корректности индекса
+    validateCoordinates(index);
+    return m_visibilityBuffer[index];
+}
+
+// Доступ к элементу буфера по индексу (константная версия)
+const std::uint32_t& VisibilityBuffer::operator()(int index) const {
+    // Проверка корректности индекса
+    validateCoordinates(index);
+    return m_visibilityBuffer[index];
+}
+
+// Валидация размеров буфера
+void VisibilityBuffer::validateDimensions(int width, int height) const {
+    // Ошибка, если размеры некорректны
+    if (width <= 0 || height <= 0) { throw std::invalid_argument("Dimensions must be positive"); }
+}
+
+// Валидация индекса
+void VisibilityBuffer::validateCoordinates(int index) const {
+    // Ошибка, если индекс некорректен
+    if (index < 0 || static_cast<std::size_t>(index) >= m_layout.size()) { throw std::out_of_range("Invalid coordinates"); }
+}
+
+// Валидация координат пикселя
+void VisibilityBuffer::validatePixel(int x, int y) const {
+    // Ошибка, если пиксель за пределами буфера
+    if (x < 0 || x >= m_layout.width() || y < 0 || y >= m_layout.height()) { throw std::out_of_range("Invalid coordinates"); }
+}
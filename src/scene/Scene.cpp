@@ -0,0 +1,64 @@
+#include "scene/Scene.hpp"
+
+// Конструктор
+Scene::Scene() {
+    // Корневой узел принадлежит сцене
+    m_root.m_scene = this;
+    m_root.m_dirty = false;
+}
+
+// Получение корневого узла
+SceneNode& Scene::getRoot() { return m_root; }
+
+// Добавление узла
+void Scene::addNode(SceneNode& node, SceneNode* parent) {
+    (parent ? *parent : m_root).addChild(node);
+}
+
+// Удаление узла
+void Scene::removeNode(SceneNode& node) {
+    if (node.m_parent && node.m_scene == this) { node.m_parent->removeChild(node); }
+}
+
+// Обновление сцены
+void Scene::update() {
+    if (!m_dirtyNodes.empty()) {
+        // Глубина узла в графе
+        auto depth = [](const SceneNode* node) {
+            int d = 0;
+            for (const SceneNode* p = node->m_parent; p; p = p->m_parent) { d++; }
+            return d;
+        };
+
+        // Сначала пересчитываются узлы ближе к корню: их поддеревья пересчитываются целиком,
+        // и изменённые потомки к своему ходу уже не помечены
+        std::sort(m_dirtyNodes.begin(), m_dirtyNodes.end(), [&](const SceneNode* a, const SceneNode* b) { return depth(a) < depth(b); });
+        for (auto& node : m_dirtyNodes) {
+            if (node->m_dirty) { node->updateWorld(); }
+        }
+        m_dirtyNodes.clear();
+    }
+
+    // Список отрисовки пересобирается только при изменении структуры графа
+    if (m_structureDirty) {
+        m_renderList.clear();
+        collect(m_root);
+
+        // Экземпляры одной геометрии идут подряд, чтобы её данные оставались в кэше
+        std::stable_sort(m_renderList.begin(), m_renderList.end(), [](const MeshInstance* a, const MeshInstance* b) {
+            return &a->getMesh() < &b->getMesh();
+        });
+
+        m_structureDirty = false;
+    }
+}
+
+// Получение списка отрисовки
+const std::vector<MeshInstance*>& Scene::getRenderList() const { return m_renderList; }
+
+// Сбор экземпляров поддерева
+void Scene::collect(SceneNode& node) {
+    // Узлы без геометрии (группы) только передают трансформацию потомкам
+    if (auto instance = dynamic_cast<MeshInstance*>(&node)) { m_renderList.push_back(instance); }
+    for (auto& child : node.m_children) { collect(*child); }
+}
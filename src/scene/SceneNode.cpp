@@ -0,0 +1,136 @@
+#include "scene/SceneNode.hpp"
+#include "scene/Scene.hpp"
+
+namespace {
+    // Счётчик версий мировых матриц (общий для всех узлов, поэтому версия однозначно определяет и узел, и его состояние)
+    std::atomic<std::uint64_t> s_worldVersion{0};
+}
+
+// Деструктор
+SceneNode::~SceneNode() {
+    // Отсоединение от родителя
+    if (m_parent) { m_parent->removeChild(*this); }
+    // Дочерние узлы остаются без родителя
+    for (auto& child : m_children) {
+        child->m_parent = nullptr;
+        child->setScene(nullptr);
+    }
+}
+
+// Добавление дочернего узла
+void SceneNode::addChild(SceneNode& child) {
+    // Узел может иметь только одного родителя
+    if (child.m_parent) { child.m_parent->removeChild(child); }
+
+    child.m_parent = this;
+    m_children.push_back(&child);
+
+    // Поддерево попадает в сцену родителя, его мировые матрицы нужно пересчитать
+    child.setScene(m_scene);
+    child.m_dirty = false;
+    child.markDirty();
+    if (m_scene) { m_scene->m_structureDirty = true; }
+}
+
+// Удаление дочернего узла
+void SceneNode::removeChild(SceneNode& child) {
+    auto it = std::find(m_children.begin(), m_children.end(), &child);
+    if (it == m_children.end()) return;
+
+    m_children.erase(it);
+    child.m_parent = nullptr;
+
+    if (m_scene) {
+        m_scene->m_structureDirty = true;
+        // Поддерево покидает сцену и не должно оставаться в списке изменённых узлов
+        Scene* scene = m_scene;
+        child.setScene(nullptr);
+        scene->m_dirtyNodes.erase(std::remove_if(scene->m_dirtyNodes.begin(), scene->m_dirtyNodes.end(),
+            [scene](const SceneNode* node) { return node->m_scene != scene; }), scene->m_dirtyNodes.end());
+    }
+}
+
+// Получение родительского узла
+SceneNode* SceneNode::getParent() const { return m_parent; }
+
+// Получение дочерних узлов
+const std::vector<SceneNode*>& SceneNode::getChildren() const { return m_children; }
+
+// Перемещение узла
+void SceneNode::translate(const Vec3d& offset) {
+    m_position += offset;
+    markDirty();
+}
+
+// Масштабирование узла
+void SceneNode::scale(const Vec3d& scale) {
+    m_scale *= scale;
+    markDirty();
+}
+
+// Вращение узла
+void SceneNode::rotate(const Vec3d& angle) {
+    m_angle += angle;
+    markDirty();
+}
+
+// Получение мировой матрицы
+const Mat4x4& SceneNode::getWorldMatrix() const { return m_matWorld; }
+
+// Получение обратной мировой матрицы
+const Mat4x4& SceneNode::getWorldInverseMatrix() const { return m_matWorldInverse; }
+
+// Проверка, отражён ли узел
+bool SceneNode::isWorldMirrored() const { return m_mirrored; }
+
+// Получение версии мировой матрицы
+std::uint64_t SceneNode::getWorldVersion() const { return m_worldVersion; }
+
+// Пометка узла как изменённого
+void SceneNode::markDirty() {
+    // Узел уже ждёт пересчёта
+    if (m_dirty) return;
+
+    m_dirty = true;
+    // Сцена пересчитает только зарегистрированные поддеревья
+    if (m_scene) { m_scene->m_dirtyNodes.push_back(this); }
+}
+
+// Привязка поддерева к сцене
+void SceneNode::setScene(Scene* scene) {
+    m_scene = scene;
+    for (auto& child : m_children) { child->setScene(scene); }
+}
+
+// Пересчёт мировых матриц узла и поддерева
+void SceneNode::updateWorld() {
+    // Матрица вращения
+    Mat4x4 matRot = Mat4x4::rotationX(m_angle.x) * Mat4x4::rotationY(m_angle.y) * Mat4x4::rotationZ(m_angle.z);
+    // Матрица перемещения
+    Mat4x4 matTrans = Mat4x4::translation(m_position.x, m_position.y, m_position.z);
+
+    // Локальная матрица: масштабирование, вращение, перемещение
+    Mat4x4 matLocal = Mat4x4::scale(m_scale.x, m_scale.y, m_scale.z) * matRot * matTrans;
+    // Обратная локальная матрица: обратное вращение и перемещение, затем обратный масштаб
+    Mat4x4 matLocalInverse = Mat4x4::inverse(matRot * matTrans) * Mat4x4::scale(1.f / m_scale.x, 1.f / m_scale.y, 1.f / m_scale.z);
+    // Отрицательный масштаб по нечётному числу осей выворачивает треугольники
+    bool localMirrored = m_scale.x * m_scale.y * m_scale.z < 0;
+
+    if (m_parent) {
+        // Мировая матрица: сначала локальная трансформация, затем трансформация родителя
+        m_matWorld = matLocal * m_parent->m_matWorld;
+        m_matWorldInverse = m_parent->m_matWorldInverse * matLocalInverse;
+        m_mirrored = localMirrored != m_parent->m_mirrored;
+    }
+    else {
+        m_matWorld = matLocal;
+        m_matWorldInverse = matLocalInverse;
+        m_mirrored = localMirrored;
+    }
+
+    m_worldVersion = ++s_worldVersion;
+    m_dirty = false;
+
+    // Мировые матрицы потомков зависят от этого узла
+    for (auto& child : m_children) { child->updateWorld(); }
+}